@@ -9,6 +9,7 @@
 // Interrupt priorities
 #define CONFIG_HIGHRES_IRQ_PRIORITY     (0<<4)
 #define CONFIG_CLOCKTIMER_IRQ_PRIORITY  (1<<4)
+#define CONFIG_OUTPUTTIMER_IRQ_PRIORITY (1<<4)
 #define CONFIG_DIO_IRQ_PRIORITY         (2<<4)
 #define CONFIG_MIDI_IRQ_PRIORITY        (3<<4)
 #define CONFIG_LCD_IRQ_PRIORITY         (4<<4)
@@ -47,17 +47,39 @@
 // CV outputs
 #define CONFIG_CV_OUTPUT_CHANNELS       8
 
+// Output latency in microseconds, gate/cv outputs are delayed by this amount to play them at exact tick times
+#define CONFIG_OUTPUT_LATENCY           1500
+
+// Sample interval in microseconds of streamed cv outputs, streamed outputs ramp between tick values at this rate
+#define CONFIG_OUTPUT_STREAM_INTERVAL   250
+
 // Model
 #define CONFIG_PATTERN_COUNT            16
 #define CONFIG_SNAPSHOT_COUNT           1
 #define CONFIG_SONG_SLOT_COUNT          64
+#ifndef CONFIG_TRACK_COUNT
 #define CONFIG_TRACK_COUNT              8
+#endif
+#define CONFIG_TRACK_BANK_SIZE          8
 #define CONFIG_STEP_COUNT               64
-#define CONFIG_ROUTE_COUNT              16
+#ifndef CONFIG_ROUTE_COUNT
+#define CONFIG_ROUTE_COUNT              64
+#endif
 #define CONFIG_MIDI_OUTPUT_COUNT        16
 #define CONFIG_USER_SCALE_COUNT         4
 #define CONFIG_USER_SCALE_SIZE          32
 
 
+// Tracks are organized in banks mapped to the track buttons.
+// Tracks beyond the CV/Gate channel count can be routed to the outputs in the layout or drive MIDI outputs.
+static_assert(CONFIG_TRACK_COUNT % CONFIG_TRACK_BANK_SIZE == 0, "track count must be a multiple of the track bank size");
+static_assert(CONFIG_TRACK_COUNT <= 32, "track count must not exceed 32");
+
 #define CONFIG_ENABLE_ASTEROIDS
 // #define CONFIG_ENABLE_INTRO
+
+// Project cue reads the next project into a second project instance to switch projects without interrupting playback.
+// Needs another ~76KB of DMA capable RAM for the second project, which the hardware has no memory for.
+#ifdef PLATFORM_SIM
+#define CONFIG_ENABLE_PROJECT_CUE
+#endif
@@ -9,6 +9,7 @@
 #include "drivers/GateOutput.h"
 #include "drivers/Lcd.h"
 #include "drivers/Midi.h"
+#include "drivers/OutputTimer.h"
 #include "drivers/SdCard.h"
 #include "drivers/UsbMidi.h"
 
@@ -28,6 +29,7 @@ static os::PeriodicTask<1024> fsTask("file", CONFIG_FILE_TASK_PRIORITY, os::time
 struct SequencerApp {
     // drivers
     ClockTimer clockTimer;
+    OutputTimer outputTimer;
     ButtonLedMatrix blm;
     Lcd lcd;
     Adc adc;
@@ -42,7 +44,7 @@ struct SequencerApp {
     // filesystem
     fs::Volume volume;
 
-    uint8_t midiMessagePayloadPool[32];
+    uint8_t midiMessagePayloadPool[4 * 48];
 
     // application
     Model model;
@@ -51,7 +53,7 @@ struct SequencerApp {
 
     SequencerApp() :
         volume(sdCard),
-        engine(model, clockTimer, adc, dac, dio, gateOutput, midi, usbMidi),
+        engine(model, clockTimer, outputTimer, adc, dac, dio, gateOutput, midi, usbMidi),
         ui(model, engine, lcd, blm, encoder, model.settings())
     {
         MidiMessage::setPayloadPool(midiMessagePayloadPool, sizeof(midiMessagePayloadPool));
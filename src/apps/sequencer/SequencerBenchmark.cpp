@@ -0,0 +1,112 @@
+#include "SequencerApp.h"
+
+#include "sim/Simulator.h"
+
+#include "args.hxx"
+
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <memory>
+
+// Engine benchmark.
+// Plays a project with an increasing number of active note tracks and reports the host time
+// spent in Engine::update() per clock tick. The simulator runs on its virtual clock, so each
+// run covers exactly the same amount of musical time. Also reports how late clock ticks are delivered by the
+// simulated clock timer and how late scheduled outputs are applied.
+
+static void setupTracks(Project &project, int activeTracks) {
+    for (int trackIndex = 0; trackIndex < CONFIG_TRACK_COUNT; ++trackIndex) {
+        project.setTrackMode(trackIndex, Track::TrackMode::Note);
+        auto &sequence = project.track(trackIndex).noteTrack().sequence(0);
+        sequence.clear();
+        if (trackIndex < activeTracks) {
+            // dense sequence with gates and retriggers on every step
+            for (int stepIndex = 0; stepIndex <= sequence.lastStep(); ++stepIndex) {
+                auto &step = sequence.step(stepIndex);
+                step.setGate(true);
+                step.setNote(stepIndex % 12);
+                step.setRetrigger(stepIndex % 4);
+            }
+        }
+    }
+}
+
+int main(int argc, char *argv[]) {
+    args::ArgumentParser parser("PER|FORMER Engine Benchmark", "");
+    args::HelpFlag help(parser, "help", "Display this help menu", { 'h', "help" });
+    args::ValueFlag<double> duration(parser, "duration", "Duration to play per track count in seconds (default: 10)", { 'd', "duration" }, 10.0);
+    args::ValueFlag<float> tempo(parser, "tempo", "Tempo in BPM (default: 300)", { 't', "tempo" }, 300.f);
+
+    try {
+        parser.ParseCLI(argc, argv);
+    } catch (const args::Help &) {
+        std::cout << parser;
+        return 0;
+    } catch (const args::ParseError &e) {
+        std::cerr << e.what() << std::endl;
+        std::cerr << parser;
+        return 1;
+    }
+
+    std::unique_ptr<SequencerApp> app;
+    std::chrono::duration<double> engineTime(0);
+
+    sim::Simulator simulator({
+        .create = [&] () {
+            app.reset(new SequencerApp());
+        },
+        .destroy = [&] () {
+            app.reset();
+        },
+        .update = [&] () {
+            auto start = std::chrono::high_resolution_clock::now();
+            app->engine.update();
+            engineTime += std::chrono::high_resolution_clock::now() - start;
+            app->ui.update();
+        }
+    });
+
+    simulator.setOffline(true);
+
+    // let the target start up
+    simulator.wait(2000);
+
+    auto &project = app->model.project();
+    project.setTempo(args::get(tempo));
+
+    int ms = int(args::get(duration) * 1000.0);
+
+    std::printf("%d tracks, %.1f BPM, %.1fs per run\n", CONFIG_TRACK_COUNT, args::get(tempo), ms / 1000.0);
+    std::printf("%8s %10s %12s %12s %12s %12s %12s %12s\n", "active", "ticks", "us/tick", "delta", "clk avg us", "clk max us", "out max us", "dac writes");
+
+    double lastUsPerTick = 0.0;
+
+    for (int activeTracks = 0; activeTracks <= CONFIG_TRACK_COUNT; ++activeTracks) {
+        setupTracks(project, activeTracks);
+
+        app->engine.clockStart();
+        // let the engine pick up the new track setup
+        simulator.wait(10);
+
+        engineTime = std::chrono::duration<double>(0);
+        app->clockTimer.resetJitter();
+        app->engine.resetStats();
+        uint32_t startTick = app->engine.tick();
+        simulator.wait(ms);
+        uint32_t ticks = app->engine.tick() - startTick;
+
+        app->engine.clockStop();
+        simulator.wait(10);
+
+        double usPerTick = ticks > 0 ? engineTime.count() * 1e6 / ticks : 0.0;
+        const auto &jitter = app->clockTimer.jitter();
+        auto stats = app->engine.stats();
+        std::printf("%8d %10u %12.3f %12.3f %12.1f %12.1f %12u %12u\n",
+            activeTracks, ticks, usPerTick, activeTracks > 0 ? usPerTick - lastUsPerTick : 0.0,
+            jitter.averageUs(), jitter.maxUs, stats.outputs.maxLateness, stats.outputs.dacWrites);
+        lastUsPerTick = usPerTick;
+    }
+
+    return 0;
+}
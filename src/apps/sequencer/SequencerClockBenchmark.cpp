@@ -0,0 +1,331 @@
+#include "Config.h"
+
+#include "engine/Clock.h"
+
+#include "drivers/ClockTimer.h"
+
+#include "core/midi/MidiMessage.h"
+
+#include "sim/Simulator.h"
+
+#include "args.hxx"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+// Clock jitter and drift analysis.
+// Runs the sequencer clock in master or slave mode and compares the generated ticks against ideal tick times.
+// In slave mode a synthetic master sends clock pulses (MIDI clock or external clock input) with configurable
+// timing jitter, crystal drift, dropouts and tempo ramps. The clock timer is advanced at microsecond resolution
+// instead of the simulator's 1ms steps, so results reflect the clock's own behavior.
+//
+// Reported metrics:
+// - latency: median error of generated ticks against ideal ticks once locked (positive = late)
+// - jitter: percentiles of the absolute deviation from the latency once locked
+// - lock-in: time until the error stays within the tolerance for the rest of the run
+// - drift: slope of the error over time once locked
+// Without lock-in, jitter and drift are measured over the second half of the run.
+// - missing: ideal ticks not generated at the end of the run (lost pulses are never caught up)
+
+enum class Source {
+    Master,
+    Midi,
+    External,
+};
+
+struct Scenario {
+    Source source = Source::Midi;
+    Clock::SlaveSync sync = Clock::SlaveSync::Pll;
+    uint32_t responseMs = 250;
+    double bpm = 120.0;
+    double bpmEnd = 120.0;
+    int ppqn = 24;              // pulses per quarter note sent by the master
+    double jitterUs = 0.0;      // standard deviation of pulse timing
+    double driftPpm = 0.0;      // master clock deviation
+    double dropout = 0.0;       // probability of a pulse getting lost
+    double duration = 30.0;     // seconds
+    double toleranceUs = 500.0; // lock-in tolerance
+    uint32_t resolutionUs = 1;
+    uint32_t seed = 0;
+};
+
+struct Result {
+    size_t idealTicks = 0;
+    size_t generatedTicks = 0;
+    size_t droppedPulses = 0;
+    bool locked = false;
+    double lockInMs = 0.0;
+    double latencyUs = 0.0;
+    double driftPpm = 0.0;
+    double jitterUs[4] = { 0.0, 0.0, 0.0, 0.0 }; // p50, p95, p99, max
+    double bpm = 0.0;
+    double trueBpm = 0.0;
+};
+
+struct NullListener : public Clock::Listener {
+    void onClockOutput(const Clock::OutputState &state) override {}
+    void onClockMidi(uint8_t data) override {}
+};
+
+static double scenarioBpm(const Scenario &scenario, double timeUs) {
+    double t = std::min(1.0, timeUs / (scenario.duration * 1e6));
+    return scenario.bpm + (scenario.bpmEnd - scenario.bpm) * t;
+}
+
+// generates pulse times (us) of the master following the tempo ramp, including drift
+static std::vector<double> generatePulses(const Scenario &scenario, int ppqn) {
+    std::vector<double> pulses;
+    double durationUs = scenario.duration * 1e6;
+    double time = 0.0;
+    // one extra pulse to interpolate the last ideal ticks
+    while (pulses.empty() || pulses.back() <= durationUs) {
+        pulses.push_back(time);
+        time += (60e6 / (scenarioBpm(scenario, time) * ppqn)) * (1.0 + scenario.driftPpm * 1e-6);
+    }
+    return pulses;
+}
+
+static double percentile(std::vector<double> &values, double p) {
+    if (values.empty()) {
+        return 0.0;
+    }
+    size_t index = std::min(values.size() - 1, size_t(p * values.size()));
+    std::nth_element(values.begin(), values.begin() + index, values.end());
+    return values[index];
+}
+
+static Result run(const Scenario &scenario) {
+    Result result;
+
+    ClockTimer clockTimer;
+    NullListener listener;
+    Clock clock(clockTimer);
+    clock.init();
+    clock.setListener(&listener);
+
+    std::mt19937 rng(scenario.seed);
+    std::normal_distribution<double> jitter(0.0, std::max(1e-9, scenario.jitterUs));
+    std::uniform_real_distribution<double> chance(0.0, 1.0);
+
+    const int slave = 0;
+    int pulsePpqn = scenario.source == Source::Midi ? 24 : scenario.ppqn;
+    int divisor = CONFIG_PPQN / pulsePpqn;
+
+    // ideal ticks are interpolated between the undisturbed master pulses
+    auto pulses = generatePulses(scenario, scenario.source == Source::Master ? CONFIG_PPQN : pulsePpqn);
+    std::vector<double> idealTicks;
+    if (scenario.source == Source::Master) {
+        idealTicks.assign(pulses.begin(), pulses.end() - 1);
+    } else {
+        for (size_t i = 0; i + 1 < pulses.size(); ++i) {
+            for (int j = 0; j < divisor; ++j) {
+                idealTicks.push_back(pulses[i] + (pulses[i + 1] - pulses[i]) * j / divisor);
+            }
+        }
+    }
+
+    // delivered pulses with jitter and dropouts, kept in order
+    std::vector<double> delivered;
+    if (scenario.source != Source::Master) {
+        double last = 0.0;
+        for (size_t i = 0; i + 1 < pulses.size(); ++i) {
+            if (i > 0 && chance(rng) < scenario.dropout) {
+                ++result.droppedPulses;
+                continue;
+            }
+            double time = std::max(last, pulses[i] + (scenario.jitterUs > 0.0 ? jitter(rng) : 0.0));
+            delivered.push_back(time);
+            last = time;
+        }
+    }
+
+    // start
+    if (scenario.source == Source::Master) {
+        clock.setMode(Clock::Mode::Master);
+        clock.setMasterBpm(scenario.bpm);
+        clock.masterStart();
+    } else {
+        clock.setMode(Clock::Mode::Slave);
+        clock.setSlaveSync(scenario.sync, scenario.responseMs);
+        clock.slaveConfigure(slave, divisor, true);
+        if (scenario.source == Source::Midi) {
+            clock.slaveHandleMidi(slave, MidiMessage::Start);
+        } else {
+            clock.slaveStart(slave);
+        }
+    }
+
+    std::vector<double> ticks;
+    size_t nextPulse = 0;
+    uint64_t durationUs = uint64_t(scenario.duration * 1e6);
+
+    for (uint64_t now = 0; now < durationUs; now += scenario.resolutionUs) {
+        while (nextPulse < delivered.size() && delivered[nextPulse] <= now) {
+            if (scenario.source == Source::Midi) {
+                clock.slaveHandleMidi(slave, MidiMessage::Tick);
+            } else {
+                clock.slaveTick(slave);
+            }
+            ++nextPulse;
+        }
+
+        // engine updates the master tempo every millisecond
+        if (scenario.source == Source::Master && now % 1000 == 0) {
+            clock.setMasterBpm(scenarioBpm(scenario, now));
+        }
+
+        clockTimer.advance(now * 0.001);
+
+        while (ticks.size() < clock.tick()) {
+            ticks.push_back(now);
+        }
+    }
+
+    // ideal ticks that should have been generated by the end of the run
+    result.idealTicks = std::upper_bound(idealTicks.begin(), idealTicks.end(), double(durationUs)) - idealTicks.begin();
+    result.generatedTicks = ticks.size();
+    result.bpm = clock.bpm();
+    result.trueBpm = scenarioBpm(scenario, durationUs) / (1.0 + scenario.driftPpm * 1e-6);
+
+    size_t count = std::min(ticks.size(), idealTicks.size());
+    if (count == 0) {
+        return result;
+    }
+
+    std::vector<double> errors(count);
+    for (size_t i = 0; i < count; ++i) {
+        errors[i] = ticks[i] - idealTicks[i];
+    }
+
+    // steady state latency from the second half of the run
+    std::vector<double> tail(errors.begin() + count / 2, errors.end());
+    result.latencyUs = percentile(tail, 0.5);
+
+    // lock-in is reached after the last tick outside the tolerance, it must hold for at least the second half
+    size_t lockIndex = 0;
+    for (size_t i = 0; i < count; ++i) {
+        if (std::abs(errors[i] - result.latencyUs) > scenario.toleranceUs) {
+            lockIndex = i + 1;
+        }
+    }
+    result.locked = lockIndex <= count / 2;
+    result.lockInMs = result.locked ? idealTicks[lockIndex] * 0.001 : 0.0;
+
+    // jitter and drift once locked (or over the second half if the clock never locks)
+    size_t first = result.locked ? lockIndex : count / 2;
+    std::vector<double> deviations;
+    double sumT = 0.0, sumE = 0.0, sumTT = 0.0, sumTE = 0.0;
+    for (size_t i = first; i < count; ++i) {
+        deviations.push_back(std::abs(errors[i] - result.latencyUs));
+        double t = idealTicks[i] * 1e-6;
+        sumT += t;
+        sumE += errors[i];
+        sumTT += t * t;
+        sumTE += t * errors[i];
+    }
+    double n = deviations.size();
+    double denom = n * sumTT - sumT * sumT;
+    result.driftPpm = denom > 0.0 ? (n * sumTE - sumT * sumE) / denom : 0.0; // us per second
+
+    result.jitterUs[0] = percentile(deviations, 0.5);
+    result.jitterUs[1] = percentile(deviations, 0.95);
+    result.jitterUs[2] = percentile(deviations, 0.99);
+    result.jitterUs[3] = *std::max_element(deviations.begin(), deviations.end());
+
+    return result;
+}
+
+int main(int argc, char *argv[]) {
+    args::ArgumentParser parser("PER|FORMER Clock Benchmark", "");
+    args::HelpFlag help(parser, "help", "Display this help menu", { 'h', "help" });
+    args::ValueFlag<std::string> source(parser, "source", "Clock source: master, midi or external (default: midi)", { 's', "source" }, "midi");
+    args::ValueFlag<std::string> sync(parser, "sync", "Slave synchronization: pulse or pll (default: pll)", { "sync" }, "pll");
+    args::ValueFlag<uint32_t> response(parser, "response", "Slave pll response time in ms (default: 250)", { "response" }, 250);
+    args::ValueFlag<double> bpm(parser, "bpm", "Master tempo in BPM (default: 120)", { 'b', "bpm" }, 120.0);
+    args::ValueFlag<double> bpmEnd(parser, "bpm-end", "Master tempo at the end of the run for tempo ramps (default: same as --bpm)", { "bpm-end" });
+    args::ValueFlag<int> ppqn(parser, "ppqn", "Pulses per quarter note of the external clock (default: 4)", { 'p', "ppqn" }, 4);
+    args::ValueFlag<double> jitter(parser, "jitter", "Standard deviation of the pulse timing in us (default: 0)", { 'j', "jitter" }, 0.0);
+    args::ValueFlag<double> drift(parser, "drift", "Master clock drift in ppm (default: 0)", { "drift" }, 0.0);
+    args::ValueFlag<double> dropout(parser, "dropout", "Probability of a pulse getting lost (default: 0)", { "dropout" }, 0.0);
+    args::ValueFlag<double> duration(parser, "duration", "Duration in seconds (default: 30)", { 'd', "duration" }, 30.0);
+    args::ValueFlag<double> tolerance(parser, "tolerance", "Lock-in tolerance in us (default: 500)", { 't', "tolerance" }, 500.0);
+    args::ValueFlag<uint32_t> resolution(parser, "resolution", "Timer resolution in us (default: 1)", { 'r', "resolution" }, 1);
+    args::ValueFlag<uint32_t> seed(parser, "seed", "Random seed (default: 0)", { "seed" }, 0);
+
+    try {
+        parser.ParseCLI(argc, argv);
+    } catch (const args::Help &) {
+        std::cout << parser;
+        return 0;
+    } catch (const args::ParseError &e) {
+        std::cerr << e.what() << std::endl;
+        std::cerr << parser;
+        return 1;
+    }
+
+    Scenario scenario;
+    if (args::get(source) == "master") {
+        scenario.source = Source::Master;
+    } else if (args::get(source) == "midi") {
+        scenario.source = Source::Midi;
+    } else if (args::get(source) == "external") {
+        scenario.source = Source::External;
+    } else {
+        std::cerr << "Invalid clock source '" << args::get(source) << "'" << std::endl;
+        return 1;
+    }
+    if (args::get(sync) == "pulse") {
+        scenario.sync = Clock::SlaveSync::Pulse;
+    } else if (args::get(sync) == "pll") {
+        scenario.sync = Clock::SlaveSync::Pll;
+    } else {
+        std::cerr << "Invalid slave synchronization '" << args::get(sync) << "'" << std::endl;
+        return 1;
+    }
+    scenario.responseMs = args::get(response);
+    scenario.bpm = args::get(bpm);
+    scenario.bpmEnd = bpmEnd ? args::get(bpmEnd) : scenario.bpm;
+    scenario.ppqn = args::get(ppqn);
+    scenario.jitterUs = args::get(jitter);
+    scenario.driftPpm = args::get(drift);
+    scenario.dropout = args::get(dropout);
+    scenario.duration = args::get(duration);
+    scenario.toleranceUs = args::get(tolerance);
+    scenario.resolutionUs = std::max(uint32_t(1), args::get(resolution));
+    scenario.seed = args::get(seed);
+
+    if (scenario.ppqn <= 0 || CONFIG_PPQN % scenario.ppqn != 0) {
+        std::cerr << "PPQN must divide " << CONFIG_PPQN << std::endl;
+        return 1;
+    }
+
+    // the clock timer driver needs a simulator instance, the simulator itself is never stepped
+    sim::Simulator simulator({
+        .create = [] () {},
+        .destroy = [] () {},
+        .update = [] () {}
+    });
+
+    auto result = run(scenario);
+
+    std::printf("source:    %s (sync %s, response %u ms)\n", args::get(source).c_str(), args::get(sync).c_str(), unsigned(scenario.responseMs));
+    std::printf("tempo:     %.2f -> %.2f BPM (clock reports %.2f BPM, true %.2f BPM)\n", scenario.bpm, scenario.bpmEnd, result.bpm, result.trueBpm);
+    std::printf("ticks:     %zu generated, %zu ideal, %ld missing\n", result.generatedTicks, result.idealTicks, long(result.idealTicks) - long(result.generatedTicks));
+    std::printf("pulses:    %zu dropped\n", result.droppedPulses);
+    if (result.locked) {
+        std::printf("lock-in:   %.1f ms\n", result.lockInMs);
+    } else {
+        std::printf("lock-in:   not locked within %.0f us\n", scenario.toleranceUs);
+    }
+    std::printf("latency:   %.1f us\n", result.latencyUs);
+    std::printf("jitter:    p50 %.1f us, p95 %.1f us, p99 %.1f us, max %.1f us\n", result.jitterUs[0], result.jitterUs[1], result.jitterUs[2], result.jitterUs[3]);
+    std::printf("drift:     %.1f us/s\n", result.driftPpm);
+
+    return result.locked ? 0 : 2;
+}
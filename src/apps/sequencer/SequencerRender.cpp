@@ -0,0 +1,144 @@
+#include "SequencerApp.h"
+
+#include "sim/Simulator.h"
+#include "sim/OfflineRenderer.h"
+
+#include "core/profiler/Profiler.h"
+
+#include "args.hxx"
+
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <memory>
+
+// Headless offline renderer.
+// Loads a project, starts playback and records all gate/CV/MIDI outputs to a file.
+// The simulator runs on its virtual clock, so rendering is not tied to wall-clock time.
+
+// Writes all profiler intervals and counters as CSV.
+// Interval timings are in microseconds of host time scaled to the target CPU frequency.
+static bool saveProfile(const std::string &filename) {
+#if CONFIG_ENABLE_PROFILER
+    std::ofstream ofs(filename);
+    if (!ofs.good()) {
+        return false;
+    }
+    ofs << "name,count,min,mean,max";
+    for (int bin = 0; bin < Profiler::HistogramBins - 1; ++bin) {
+        ofs << ",<" << Profiler::binLimitUs(bin);
+    }
+    ofs << ",>=" << Profiler::binLimitUs(Profiler::HistogramBins - 2) << std::endl;
+    for (int i = 0; i < Profiler::intervalCount(); ++i) {
+        const auto &interval = Profiler::interval(i);
+        ofs << interval.desc << "," << interval.count;
+        if (interval.count > 0) {
+            ofs << "," << Profiler::cyclesToUs(interval.min)
+                << "," << Profiler::cyclesToUs(interval.mean())
+                << "," << Profiler::cyclesToUs(interval.max);
+        } else {
+            ofs << ",,,";
+        }
+        for (int bin = 0; bin < Profiler::HistogramBins; ++bin) {
+            ofs << "," << interval.histogram[bin];
+        }
+        ofs << std::endl;
+    }
+    for (int i = 0; i < Profiler::counterCount(); ++i) {
+        const auto &counter = Profiler::counter(i);
+        ofs << counter.desc << "," << counter.count << std::endl;
+    }
+    return true;
+#else
+    std::cerr << "Profiler is disabled (set CONFIG_ENABLE_PROFILER to 1)" << std::endl;
+    return false;
+#endif
+}
+
+int main(int argc, char *argv[]) {
+    args::ArgumentParser parser("PER|FORMER Offline Renderer", "");
+    args::HelpFlag help(parser, "help", "Display this help menu", { 'h', "help" });
+    args::ValueFlag<int> slot(parser, "slot", "Project slot to load (1-based, default: last project)", { 's', "slot" });
+    args::ValueFlag<double> duration(parser, "duration", "Duration to render in seconds (default: 60)", { 'd', "duration" }, 60.0);
+    args::Flag text(parser, "text", "Write output as text instead of binary trace", { 't', "text" });
+    args::ValueFlag<std::string> profile(parser, "profile", "Write profiler statistics of the rendered section to a CSV file", { 'p', "profile" });
+    args::Positional<std::string> output(parser, "output", "Output file");
+
+    try {
+        parser.ParseCLI(argc, argv);
+    } catch (const args::Help &) {
+        std::cout << parser;
+        return 0;
+    } catch (const args::ParseError &e) {
+        std::cerr << e.what() << std::endl;
+        std::cerr << parser;
+        return 1;
+    }
+
+    if (!output) {
+        std::cerr << "No output file specified" << std::endl;
+        std::cerr << parser;
+        return 1;
+    }
+
+    std::unique_ptr<SequencerApp> app;
+
+    sim::Simulator simulator({
+        .create = [&] () {
+            app.reset(new SequencerApp());
+        },
+        .destroy = [&] () {
+            app.reset();
+        },
+        .update = [&] () {
+            app->update();
+        }
+    });
+
+    simulator.setOffline(true);
+
+    sim::OfflineRenderer renderer(simulator);
+
+    // let the target start up and auto-load the last project
+    simulator.wait(2000);
+
+    if (slot) {
+        app->engine.suspend();
+        auto result = FileManager::readProject(app->model.project(), args::get(slot) - 1);
+        app->engine.resume();
+        if (result != fs::OK) {
+            std::cerr << "Failed to load project from slot " << args::get(slot) << " (" << fs::errorToString(result) << ")" << std::endl;
+            return 1;
+        }
+    }
+
+    app->engine.clockStart();
+
+    Profiler::reset();
+    app->lcd.resetStats();
+
+    auto start = std::chrono::high_resolution_clock::now();
+    int ms = int(args::get(duration) * 1000.0);
+    renderer.render(ms);
+    auto elapsed = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start).count();
+
+    if (text) {
+        renderer.saveToText(args::get(output));
+    } else {
+        renderer.saveToFile(args::get(output));
+    }
+
+    if (profile && !saveProfile(args::get(profile))) {
+        std::cerr << "Failed to write profile to " << args::get(profile) << std::endl;
+    }
+
+    std::cout << "Rendered " << (ms / 1000.0) << "s in " << elapsed << "s (" << (ms / 1000.0) / elapsed << "x real-time)" << std::endl;
+
+    const auto &lcd = app->lcd;
+    if (lcd.frames() > 0) {
+        std::cout << "LCD: " << lcd.frames() << " frames, " << lcd.totalBytes() / lcd.frames() << " bytes/frame on average"
+                  << " (full frame: " << Lcd::FullFrameBytes << " bytes)" << std::endl;
+    }
+
+    return 0;
+}
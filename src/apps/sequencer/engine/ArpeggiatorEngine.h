@@ -4,6 +4,8 @@
 
 #include "model/Arpeggiator.h"
 
+#include "core/utils/Random.h"
+
 #include <array>
 
 #include <cstdint>
@@ -20,7 +22,7 @@ public:
         uint8_t velocity;
     };
 
-    ArpeggiatorEngine(const Arpeggiator &arpeggiator);
+    ArpeggiatorEngine(const Arpeggiator &arpeggiator, Random &rng);
 
     void reset();
 
@@ -43,6 +45,7 @@ private:
     static constexpr int MaxNotes = 8;
 
     const Arpeggiator &_arpeggiator;
+    Random &_rng;
 
     int _stepIndex;
     int _noteIndex;
@@ -7,6 +7,7 @@
 #include "core/math/Math.h"
 #include "core/midi/MidiMessage.h"
 #include "drivers/ClockTimer.h"
+#include "drivers/HighResolutionTimer.h"
 
 #include <cmath>
 
@@ -133,35 +134,18 @@ void Clock::slaveTick(int slave) {
     if (_state == State::SlaveRunning && _activeSlave == slave) {
         uint32_t divisor = _slaves[slave].divisor;
 
-        // protect against clock rate overload
-        _slaveSubTicksPending = std::min(_slaveSubTicksPending + divisor, 2 * divisor);
-
-        // time past since last tick
-        uint32_t periodUs = _elapsedUs - _lastSlaveTickUs;
-
         // default tick period to 120 bpm
         if (_slaveTickPeriodUs == 0) {
             _slaveTickPeriodUs = (60 * 1000000 * divisor) / (120 * _ppqn);
         }
 
-        // update tick period if we have a valid measurement
-        if (periodUs > 0 && _lastSlaveTickUs > 0) {
-            _slaveTickPeriodUs = periodUs;
-        }
-
-        _slaveSubTickPeriodUs = _slaveTickPeriodUs / _slaveSubTicksPending;
-        if (_elapsedUs - _nextSlaveSubTickUs > 1000) {
-            _nextSlaveSubTickUs = _elapsedUs;
-        } else {
-            _nextSlaveSubTickUs += _slaveSubTickPeriodUs;
-        }
-
-        // estimate slave BPM
-        if (periodUs > 0 && _lastSlaveTickUs > 0) {
-            float bpm = (60.f * 1000000 * divisor) / (periodUs * _ppqn);
-            _slaveBpmFiltered = 0.9f * _slaveBpmFiltered + 0.1f * bpm;
-            _slaveBpmAvg.push(_slaveBpmFiltered);
-            _slaveBpm = _slaveBpmAvg();
+        switch (_slaveSync) {
+        case SlaveSync::Pulse:
+            slaveTickPulse(divisor);
+            break;
+        case SlaveSync::Pll:
+            slaveTickPll(divisor);
+            break;
         }
 
         _lastSlaveTickUs = _elapsedUs;
@@ -245,6 +229,18 @@ void Clock::slaveReset(int slave) {
     _timer.disable();
 }
 
+void Clock::setSlaveSync(SlaveSync sync, uint32_t responseMs) {
+    os::InterruptLock lock;
+
+    _pllResponseUs = std::max(uint32_t(1), responseMs) * 1000.f;
+    if (sync != _slaveSync) {
+        _slaveSync = sync;
+        // restart synchronization on the next pulse
+        _slaveSubTicksPending = 0;
+        _pllPulses = 0;
+    }
+}
+
 void Clock::slaveHandleMidi(int slave, uint8_t msg) {
     switch (MidiMessage::realTimeMessage(msg)) {
     case MidiMessage::Tick:
@@ -309,11 +305,23 @@ bool Clock::checkTick(uint32_t *tick) {
     return false;
 }
 
+bool Clock::checkTick(uint32_t *tick, uint32_t *time) {
+    os::InterruptLock lock;
+
+    if (!checkTick(tick)) {
+        return false;
+    }
+    // fall back to the current time if the tick is too old to be in the history
+    *time = _tick - *tick <= TickTimeCount ? _tickTimes[*tick & (TickTimeCount - 1)] : HighResolutionTimer::us();
+    return true;
+}
+
 void Clock::onClockTimerTick() {
     os::InterruptLock lock;
 
     switch (_state) {
     case State::MasterRunning: {
+        _tickTimes[_tick & (TickTimeCount - 1)] = HighResolutionTimer::us();
         outputTick(_tick);
         ++_tick;
         _elapsedUs += _timer.period();
@@ -322,11 +330,13 @@ void Clock::onClockTimerTick() {
     case State::SlaveRunning: {
         _elapsedUs += _timer.period();
 
-        if (_slaveSubTicksPending > 0 && _elapsedUs >= _nextSlaveSubTickUs) {
-            outputTick(_tick);
-            ++_tick;
-            --_slaveSubTicksPending;
-            _nextSlaveSubTickUs += _slaveSubTickPeriodUs;
+        switch (_slaveSync) {
+        case SlaveSync::Pulse:
+            slaveTimerPulse();
+            break;
+        case SlaveSync::Pll:
+            slaveTimerPll();
+            break;
         }
 
         if (_mode == Mode::Auto && (_elapsedUs - _lastSlaveTickUs) > 500000) {
@@ -393,10 +403,126 @@ void Clock::setupMasterTimer() {
 void Clock::setupSlaveTimer() {
     _elapsedUs = 0;
     _lastSlaveTickUs = 0;
+    _pllPulses = 0;
 
     _timer.setPeriod(SlaveTimerPeriod);
 }
 
+void Clock::slaveTickPulse(uint32_t divisor) {
+    // protect against clock rate overload
+    _slaveSubTicksPending = std::min(_slaveSubTicksPending + divisor, 2 * divisor);
+
+    // time past since last tick
+    uint32_t periodUs = _elapsedUs - _lastSlaveTickUs;
+
+    // update tick period if we have a valid measurement
+    if (periodUs > 0 && _lastSlaveTickUs > 0) {
+        _slaveTickPeriodUs = periodUs;
+    }
+
+    _slaveSubTickPeriodUs = _slaveTickPeriodUs / _slaveSubTicksPending;
+    if (_elapsedUs - _nextSlaveSubTickUs > 1000) {
+        _nextSlaveSubTickUs = _elapsedUs;
+    } else {
+        _nextSlaveSubTickUs += _slaveSubTickPeriodUs;
+    }
+
+    // estimate slave BPM
+    if (periodUs > 0 && _lastSlaveTickUs > 0) {
+        updateSlaveBpm(divisor, periodUs);
+    }
+}
+
+void Clock::slaveTickPll(uint32_t divisor) {
+    uint32_t time = _elapsedUs;
+
+    if (_pllPulses == 0 || divisor != _pllDivisor) {
+        // first pulse starts a new pulse interval right away
+        _pllPulseTick = _tick;
+        _pllPhaseUs = 0.f;
+        _pllPeriodUs = _slaveTickPeriodUs;
+        _pllRateUs = 0.f;
+        _pllIntervalUs = _pllPeriodUs;
+        _pllDivisor = divisor;
+        _pllPulses = 1;
+    } else {
+        float elapsedUs = float(time - _pllPulseUs) - _pllPhaseUs;
+
+        if (_pllPulses == 1) {
+            // second pulse gives the first period measurement
+            _pllPeriodUs = std::max(float(SlaveTimerPeriod), elapsedUs);
+            _pllRateUs = 0.f;
+            _pllPhaseUs = 0.f;
+        } else {
+            // pulses arriving after multiple periods are treated as lost pulses, their ticks are caught up
+            int lost = clamp(int(std::floor(elapsedUs / _pllIntervalUs - 0.5f)), 0, MaxLostPulses);
+            _pllPulseTick += lost * divisor;
+
+            // critically damped alpha-beta-gamma filter on the phase error, tracks phase, tempo and tempo ramps
+            float steps = lost + 1;
+            float error = elapsedUs - steps * _pllPeriodUs - 0.5f * steps * steps * _pllRateUs;
+            float theta = std::exp(-_pllPeriodUs / _pllResponseUs);
+            float alpha = 1.f - theta * theta * theta;
+            float beta = 1.5f * (1.f - theta) * (1.f - theta) * (1.f + theta);
+            float gamma = 0.5f * (1.f - theta) * (1.f - theta) * (1.f - theta);
+            _pllPhaseUs = -(1.f - alpha) * error;
+            _pllPeriodUs = std::max(float(SlaveTimerPeriod), _pllPeriodUs + steps * _pllRateUs + beta * error);
+            _pllRateUs += 2.f * gamma * error;
+        }
+
+        _pllIntervalUs = std::max(float(SlaveTimerPeriod), _pllPeriodUs + 0.5f * _pllRateUs);
+        _pllPulseTick += divisor;
+        _slaveTickPeriodUs = uint32_t(_pllIntervalUs);
+        ++_pllPulses;
+
+        updateSlaveBpm(divisor, _pllIntervalUs);
+    }
+
+    _pllPulseUs = time;
+}
+
+void Clock::slaveTimerPulse() {
+    if (_slaveSubTicksPending > 0 && _elapsedUs >= _nextSlaveSubTickUs) {
+        _tickTimes[_tick & (TickTimeCount - 1)] = HighResolutionTimer::us();
+        outputTick(_tick);
+        ++_tick;
+        --_slaveSubTicksPending;
+        _nextSlaveSubTickUs += _slaveSubTickPeriodUs;
+    }
+}
+
+void Clock::slaveTimerPll() {
+    if (_pllPulses == 0) {
+        return;
+    }
+
+    // never run ahead of the pulse interval, a late pulse holds the clock
+    int32_t tick = _tick - _pllPulseTick;
+    if (tick >= int32_t(_pllDivisor)) {
+        return;
+    }
+
+    // emit at most one tick per timer period, so catching up is spread out instead of bursting
+    float positionUs = float(_elapsedUs - _pllPulseUs) - _pllPhaseUs;
+    if (tick * _pllIntervalUs <= positionUs * _pllDivisor) {
+        _tickTimes[_tick & (TickTimeCount - 1)] = HighResolutionTimer::us();
+        outputTick(_tick);
+        ++_tick;
+    }
+}
+
+void Clock::updateSlaveBpm(uint32_t divisor, float periodUs) {
+    float bpm = (60.f * 1000000 * divisor) / (periodUs * _ppqn);
+    if (_slaveSync == SlaveSync::Pll) {
+        // pll period is already filtered
+        _slaveBpm = bpm;
+        return;
+    }
+    _slaveBpmFiltered = 0.9f * _slaveBpmFiltered + 0.1f * bpm;
+    _slaveBpmAvg.push(_slaveBpmFiltered);
+    _slaveBpm = _slaveBpmAvg();
+}
+
 void Clock::outputMidiMessage(uint8_t msg) {
     os::InterruptLock lock;
     if (_listener) {
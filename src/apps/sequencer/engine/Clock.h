@@ -19,6 +19,14 @@ public:
         Slave,
     };
 
+    // Slave synchronization
+    // Pulse: sub ticks are spread over the last measured pulse period
+    // Pll: phase and tempo are tracked continuously, sub ticks are placed on the predicted pulse grid
+    enum class SlaveSync {
+        Pulse,
+        Pll,
+    };
+
     enum Event {
         Start       = (1<<0),
         Stop        = (1<<1),
@@ -74,6 +82,10 @@ public:
     void slaveReset(int slave);
     void slaveHandleMidi(int slave, uint8_t msg);
 
+    SlaveSync slaveSync() const { return _slaveSync; }
+    // response time is the time constant the pll follows phase and tempo changes with
+    void setSlaveSync(SlaveSync sync, uint32_t responseMs);
+
     // Clock output
     void outputConfigure(int divisor, int pulse);
     void outputConfigureSwing(int swing);
@@ -82,6 +94,8 @@ public:
     // Sequencer interface
     Event checkEvent();
     bool checkTick(uint32_t *tick);
+    // also returns the time the tick was generated at (see HighResolutionTimer::us())
+    bool checkTick(uint32_t *tick, uint32_t *time);
 
 private:
     enum class State {
@@ -106,6 +120,12 @@ private:
     void setupMasterTimer();
     void setupSlaveTimer();
 
+    void slaveTickPulse(uint32_t divisor);
+    void slaveTickPll(uint32_t divisor);
+    void slaveTimerPulse();
+    void slaveTimerPll();
+    void updateSlaveBpm(uint32_t divisor, float periodUs);
+
     void outputMidiMessage(uint8_t msg);
     void outputTick(uint32_t tick);
     void outputClock(bool clock);
@@ -115,7 +135,9 @@ private:
     bool slaveEnabled(int slave) const { return _slaves[slave].enabled; }
 
     static constexpr uint32_t SlaveTimerPeriod = 100; // us
+    static constexpr int MaxLostPulses = 3;
     static constexpr size_t SlaveCount = 4;
+    static constexpr size_t TickTimeCount = 32; // must be a power of two
 
     Listener *_listener = nullptr;
 
@@ -146,17 +168,31 @@ private:
     uint32_t _requestedEvents = Reset;
     State _state = State::Idle;
 
-    volatile uint32_t _tick;
-    volatile uint32_t _tickProcessed;
+    volatile uint32_t _tick = 0;
+    volatile uint32_t _tickProcessed = 0;
+    std::array<uint32_t, TickTimeCount> _tickTimes; // generation time of the last ticks
 
     volatile int32_t _activeSlave = -1;
 
-    uint32_t _elapsedUs;
-    uint32_t _lastSlaveTickUs; // time of last call to slaveTick
+    uint32_t _elapsedUs = 0;
+    uint32_t _lastSlaveTickUs = 0; // time of last call to slaveTick
     uint32_t _slaveTickPeriodUs = 0; // slave tick period time
-    uint32_t _slaveSubTicksPending; // number of slave sub ticks pending
+    uint32_t _slaveSubTicksPending = 0; // number of slave sub ticks pending
     uint32_t _slaveSubTickPeriodUs = 0; // slave sub tick period time
-    uint32_t _nextSlaveSubTickUs; // time of next slave sub tick
+    uint32_t _nextSlaveSubTickUs = 0; // time of next slave sub tick
+
+    SlaveSync _slaveSync = SlaveSync::Pll;
+    float _pllResponseUs = 250000.f;
+
+    // pll state, pulse times are relative to the arrival of the last pulse to keep float precision
+    uint32_t _pllPulses = 0; // number of pulses since the slave timer was setup
+    uint32_t _pllPulseUs = 0; // arrival time of the last pulse
+    float _pllPhaseUs = 0.f; // estimated time of the last pulse relative to its arrival
+    float _pllPeriodUs = 0.f; // estimated pulse period at the last pulse
+    float _pllRateUs = 0.f; // estimated change of the pulse period per pulse (tempo ramps)
+    float _pllIntervalUs = 0.f; // predicted duration of the current pulse interval
+    uint32_t _pllPulseTick = 0; // first tick of the last pulse interval
+    uint32_t _pllDivisor = 1; // ticks per pulse
 
     float _slaveBpmFiltered = 0.f;
     MovingAverage<float, 4> _slaveBpmAvg;
@@ -8,29 +8,36 @@
 #include "core/Debug.h"
 #include "core/utils/Random.h"
 #include "core/math/Math.h"
+#include "core/profiler/Profiler.h"
 
 #include "model/Curve.h"
 #include "model/Types.h"
 
-static Random rng;
+PROFILER_INTERVAL(curveTrackTick, "curve track tick")
 
-static float evalStepShape(const CurveSequence::Step &step, bool variation, bool invert, float fraction) {
-    auto function = Curve::function(Curve::Type(variation ? step.shapeVariation() : step.shape()));
-    float value = function(fraction);
+static_assert(CurveSequence::Min::Max == CurveSequence::Max::Max, "min/max must have the same scale");
+
+// fixed point scale of evaluated step shapes
+static constexpr int StepShapeOne = Curve::FixedOne * CurveSequence::Max::Max;
+
+// sub tick resolution used to evaluate the shape right before the next tick
+static constexpr uint32_t StreamSubTicks = 16;
+
+// evaluates the step shape in fixed point, including the step min/max
+static int evalStepShape(const CurveSequence::Step &step, bool variation, bool invert, uint32_t position, uint32_t length) {
+    int value = Curve::evalFixed(Curve::Type(variation ? step.shapeVariation() : step.shape()), position, length);
     if (invert) {
-        value = 1.f - value;
+        value = Curve::FixedOne - value;
     }
-    float min = float(step.min()) / CurveSequence::Min::Max;
-    float max = float(step.max()) / CurveSequence::Max::Max;
-    return min + value * (max - min);
+    return step.min() * Curve::FixedOne + value * (step.max() - step.min());
 }
 
-static bool evalShapeVariation(const CurveSequence::Step &step, int probabilityBias) {
+static bool evalShapeVariation(Random &rng, const CurveSequence::Step &step, int probabilityBias) {
     int probability = clamp(step.shapeVariationProbability() + probabilityBias, 0, 8);
     return int(rng.nextRange(8)) < probability;
 }
 
-static bool evalGate(const CurveSequence::Step &step, int probabilityBias) {
+static bool evalGate(Random &rng, const CurveSequence::Step &step, int probabilityBias) {
     int probability = clamp(step.gateProbability() + probabilityBias, -1, CurveSequence::GateProbability::Max);
     return int(rng.nextRange(CurveSequence::GateProbability::Range)) <= probability;
 }
@@ -48,15 +55,19 @@ void CurveTrackEngine::reset() {
     _gateQueue.clear();
 
     changePattern();
+    lockRandom(_sequence->seed());
 }
 
 void CurveTrackEngine::restart() {
     _sequenceState.reset();
     _currentStep = -1;
     _currentStepFraction = 0.f;
+    lockRandom(_sequence->seed());
 }
 
 TrackEngine::TickResult CurveTrackEngine::tick(uint32_t tick) {
+    PROFILER_INTERVAL_SCOPE(curveTrackTick)
+
     ASSERT(_sequence != nullptr, "invalid sequence");
     const auto &sequence = *_sequence;
     const auto *linkData = _linkedTrackEngine ? _linkedTrackEngine->linkData() : nullptr;
@@ -88,11 +99,11 @@ TrackEngine::TickResult CurveTrackEngine::tick(uint32_t tick) {
             // advance sequence
             switch (_curveTrack.playMode()) {
             case Types::PlayMode::Aligned:
-                _sequenceState.advanceAligned(relativeTick / divisor, sequence.runMode(), sequence.firstStep(), sequence.lastStep(), rng);
+                _sequenceState.advanceAligned(relativeTick / divisor, sequence.runMode(), sequence.firstStep(), sequence.lastStep(), _rng);
                 triggerStep(tick, divisor);
                 break;
             case Types::PlayMode::Free:
-                _sequenceState.advanceFree(sequence.runMode(), sequence.firstStep(), sequence.lastStep(), rng);
+                _sequenceState.advanceFree(sequence.runMode(), sequence.firstStep(), sequence.lastStep(), _rng);
                 triggerStep(tick, divisor);
                 break;
             case Types::PlayMode::Last:
@@ -143,6 +154,11 @@ void CurveTrackEngine::update(float dt) {
         _cvOutput = _cvOutputTarget = range.denormalize(_recordValue);
     }
 
+    if (running && !recording && isStreaming()) {
+        updateStreamOutput();
+        return;
+    }
+
     float offset = mute() ? 0.f : _curveTrack.offsetVolts();
 
     if (_curveTrack.slideTime() > 0) {
@@ -150,10 +166,16 @@ void CurveTrackEngine::update(float dt) {
     } else {
         _cvOutput = _cvOutputTarget + offset;
     }
+    _cvOutputNext = _cvOutput;
 }
 
 void CurveTrackEngine::changePattern() {
-    _sequence = &_curveTrack.sequence(pattern());
+    auto sequence = &_curveTrack.sequence(pattern());
+    // also called for mute/solo/fill requests, only reseed when switching to another pattern
+    if (sequence != _sequence) {
+        lockRandom(sequence->seed());
+    }
+    _sequence = sequence;
     _fillSequence = &_curveTrack.sequence(std::min(pattern() + 1, CONFIG_PATTERN_COUNT - 1));
 }
 
@@ -166,15 +188,15 @@ void CurveTrackEngine::triggerStep(uint32_t tick, uint32_t divisor) {
     _currentStep = SequenceUtils::rotateStep(_sequenceState.step(), sequence.firstStep(), sequence.lastStep(), rotate);
     const auto &step = sequence.step(_currentStep);
 
-    _shapeVariation = evalShapeVariation(step, shapeProbabilityBias);
+    _shapeVariation = evalShapeVariation(_rng, step, shapeProbabilityBias);
 
-    bool fillStep = fill() && (rng.nextRange(100) < uint32_t(fillAmount()));
+    bool fillStep = fill() && (_rng.nextRange(100) < uint32_t(fillAmount()));
     _fillMode = fillStep ? _curveTrack.fillMode() : CurveTrack::FillMode::None;
 
     // Trigger gate pattern
     int gate = step.gate();
     for (int i = 0; i < 4; ++i) {
-        if (gate & (1 << i) && evalGate(step, gateProbabilityBias)) {
+        if (gate & (1 << i) && evalGate(_rng, step, gateProbabilityBias)) {
             uint32_t gateStart = (divisor * i) / 4;
             uint32_t gateLength = divisor / 8;
             _gateQueue.pushReplace({ Groove::applySwing(tick + gateStart, swing()), true });
@@ -191,7 +213,8 @@ void CurveTrackEngine::updateOutput(uint32_t relativeTick, uint32_t divisor) {
     const auto &sequence = *_sequence;
     const auto &range = Types::voltageRangeInfo(sequence.range());
 
-    _currentStepFraction = float(relativeTick % divisor) / divisor;
+    uint32_t stepPosition = relativeTick % divisor;
+    _currentStepFraction = float(stepPosition) / divisor;
 
     if (mute()) {
         switch (_curveTrack.muteMode()) {
@@ -210,6 +233,7 @@ void CurveTrackEngine::updateOutput(uint32_t relativeTick, uint32_t divisor) {
         case CurveTrack::MuteMode::Last:
             break;
         }
+        _cvOutputNextTarget = _cvOutputTarget;
     } else {
         bool fillVariation = _fillMode == CurveTrack::FillMode::Variation;
         bool fillNextPattern = _fillMode == CurveTrack::FillMode::NextPattern;
@@ -218,14 +242,35 @@ void CurveTrackEngine::updateOutput(uint32_t relativeTick, uint32_t divisor) {
         const auto &evalSequence = fillNextPattern ? *_fillSequence : *_sequence;
         const auto &step = evalSequence.step(_currentStep);
 
-        float value = evalStepShape(step, _shapeVariation || fillVariation, fillInvert, _currentStepFraction);
-        value = range.denormalize(value);
-        _cvOutputTarget = value;
+        bool variation = _shapeVariation || fillVariation;
+        float scale = (range.hi - range.lo) * (1.f / StepShapeOne);
+
+        int value = evalStepShape(step, variation, fillInvert, stepPosition, divisor);
+        _cvOutputTarget = range.lo + value * scale;
+
+        if (isStreaming()) {
+            // value right before the next tick, so the ramp ends on the shape and not on the next segment
+            int nextValue = evalStepShape(step, variation, fillInvert, (stepPosition + 1) * StreamSubTicks - 1, divisor * StreamSubTicks);
+            _cvOutputNextTarget = range.lo + nextValue * scale;
+        } else {
+            _cvOutputNextTarget = _cvOutputTarget;
+        }
+    }
+
+    // streamed outputs are updated right away to be scheduled at the time of the tick
+    if (isStreaming() && !isRecording()) {
+        updateStreamOutput();
     }
 
     _engine.midiOutputEngine().sendCv(_track.trackIndex(), _cvOutputTarget);
 }
 
+void CurveTrackEngine::updateStreamOutput() {
+    float offset = mute() ? 0.f : _curveTrack.offsetVolts();
+    _cvOutput = _cvOutputTarget + offset;
+    _cvOutputNext = _cvOutputNextTarget + offset;
+}
+
 bool CurveTrackEngine::isRecording() const {
     return
         _engine.state().recording() &&
@@ -259,7 +304,8 @@ void CurveTrackEngine::updateRecording(uint32_t relativeTick, uint32_t divisor)
 
     updateRecordValue();
 
-    if (_recorder.write(relativeTick, divisor, _recordValue) && _sequenceState.step() >= 0) {
+    // do not modify sequences while the project is being saved
+    if (_recorder.write(relativeTick, divisor, _recordValue) && _sequenceState.step() >= 0 && !_model.project().saveStateActive()) {
         auto &sequence = *_sequence;
         int rotate = _curveTrack.rotate();
         auto &step = sequence.step(SequenceUtils::rotateStep(_sequenceState.step(), sequence.firstStep(), sequence.lastStep(), rotate));
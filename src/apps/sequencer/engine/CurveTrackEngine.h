@@ -30,6 +30,7 @@ public:
     virtual bool activity() const override { return _activity; }
     virtual bool gateOutput(int index) const override { return _gateOutput; }
     virtual float cvOutput(int index) const override { return _cvOutput; }
+    virtual float cvOutputNext(int index) const override { return _cvOutputNext; }
     virtual float sequenceProgress() const override {
         return _currentStep < 0 ? 0.f : float(_currentStep - _sequence->firstStep()) / (_sequence->lastStep() - _sequence->firstStep());
     }
@@ -48,7 +49,9 @@ public:
 private:
     void triggerStep(uint32_t tick, uint32_t divisor);
     void updateOutput(uint32_t relativeTick, uint32_t divisor);
+    void updateStreamOutput();
 
+    bool isStreaming() const { return _curveTrack.outputMode() == CurveTrack::OutputMode::Stream; }
     bool isRecording() const;
     void updateRecordValue();
     void updateRecording(uint32_t relativeTick, uint32_t divisor);
@@ -63,7 +66,7 @@ private:
     int _monitorStepIndex = -1;
     MonitorLevel _monitorStepLevel = MonitorLevel::Min;
 
-    CurveSequence *_sequence;
+    CurveSequence *_sequence = nullptr;
     CurveSequence *_fillSequence;
     SequenceState _sequenceState;
     int _currentStep;
@@ -75,6 +78,8 @@ private:
     bool _gateOutput;
     float _cvOutput = 0.f;
     float _cvOutputTarget = 0.f;
+    float _cvOutputNext = 0.f;
+    float _cvOutputNextTarget = 0.f;
 
     struct Gate {
         uint32_t tick;
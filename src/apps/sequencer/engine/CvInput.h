@@ -16,7 +16,7 @@ public:
 
     void update();
 
-    float channel(int index) const {
+    const float &channel(int index) const {
         return _channels[index];
     }
 
@@ -2,18 +2,55 @@
 
 #include "core/math/Math.h"
 
-CvOutput::CvOutput(Dac &dac, const Calibration &calibration) :
-    _dac(dac),
+#include <algorithm>
+
+CvOutput::CvOutput(const Calibration &calibration) :
     _calibration(calibration)
 {}
 
 void CvOutput::init() {
     _channels.fill(0.f);
+    _nextChannels.fill(0.f);
+    for (int i = 0; i < Channels; ++i) {
+        updateCalibration(i);
+        _values[i] = _nextValues[i] = voltsToValue(i, 0.f);
+    }
+    _convertedChannels.fill(0.f);
+    _convertedNextChannels.fill(0.f);
 }
 
 void CvOutput::update() {
     for (int i = 0; i < Channels; ++i) {
-        _dac.setValue(i, _calibration.cvOutput(i).voltsToValue(_channels[i]));
+        bool calibrationChanged = _channelCalibrations[i].revision != _calibration.cvOutput(i).revision();
+        if (calibrationChanged) {
+            updateCalibration(i);
+        }
+        if (calibrationChanged || _channels[i] != _convertedChannels[i]) {
+            _values[i] = voltsToValue(i, _channels[i]);
+            _convertedChannels[i] = _channels[i];
+        }
+        if (calibrationChanged || _nextChannels[i] != _convertedNextChannels[i]) {
+            _nextValues[i] = _nextChannels[i] == _channels[i] ? _values[i] : voltsToValue(i, _nextChannels[i]);
+            _convertedNextChannels[i] = _nextChannels[i];
+        }
     }
-    _dac.write();
+}
+
+void CvOutput::updateCalibration(int index) {
+    const auto &cvOutput = _calibration.cvOutput(index);
+    auto &channelCalibration = _channelCalibrations[index];
+
+    for (int segment = 0; segment < ChannelCalibration::Segments; ++segment) {
+        float slope = float(cvOutput.item(segment + 1) - cvOutput.item(segment)) * Calibration::CvOutput::ItemsPerVolt;
+        channelCalibration.slopes[segment] = slope;
+        channelCalibration.offsets[segment] = cvOutput.item(segment) - slope * Calibration::CvOutput::itemToVolts(segment);
+    }
+    channelCalibration.revision = cvOutput.revision();
+}
+
+Dac::Value CvOutput::voltsToValue(int index, float volts) const {
+    const auto &channelCalibration = _channelCalibrations[index];
+    volts = clamp(volts, float(Calibration::CvOutput::MinVoltage), float(Calibration::CvOutput::MaxVoltage));
+    int segment = std::min(int((volts - Calibration::CvOutput::MinVoltage) * Calibration::CvOutput::ItemsPerVolt), ChannelCalibration::Segments - 1);
+    return channelCalibration.offsets[segment] + channelCalibration.slopes[segment] * volts;
 }
@@ -12,22 +12,59 @@ class CvOutput {
 public:
     static constexpr int Channels = CONFIG_CV_OUTPUT_CHANNELS;
 
-    CvOutput(Dac &dac, const Calibration &calibration);
+    CvOutput(const Calibration &calibration);
 
     void init();
 
+    // converts channel voltages to calibrated dac values, the values are written by the OutputScheduler
+    // only channels with changed voltages or calibration are converted
     void update();
 
-    float channel(int index) const {
+    const float &channel(int index) const {
         return _channels[index];
     }
 
     void setChannel(int index, float value) {
         _channels[index] = value;
+        _nextChannels[index] = value;
+    }
+
+    // channel voltage at the next tick, streamed channels ramp towards it (set after setChannel)
+    float nextChannel(int index) const {
+        return _nextChannels[index];
+    }
+
+    void setNextChannel(int index, float value) {
+        _nextChannels[index] = value;
+    }
+
+    Dac::Value value(int index) const {
+        return _values[index];
+    }
+
+    Dac::Value nextValue(int index) const {
+        return _nextValues[index];
     }
 
 private:
-    Dac &_dac;
+    // calibration curve of a channel as linear segments (value = offset + slope * volts), per volt from MinVoltage
+    struct ChannelCalibration {
+        static constexpr int Segments = Calibration::CvOutput::ItemCount - 1;
+
+        uint32_t revision;
+        std::array<float, Segments> offsets;
+        std::array<float, Segments> slopes;
+    };
+
+    void updateCalibration(int index);
+    Dac::Value voltsToValue(int index, float volts) const;
+
     const Calibration &_calibration;
+    std::array<ChannelCalibration, Channels> _channelCalibrations;
+    std::array<float, Channels> _convertedChannels;
+    std::array<float, Channels> _convertedNextChannels;
     std::array<float, Channels> _channels;
+    std::array<float, Channels> _nextChannels;
+    std::array<Dac::Value, Channels> _values;
+    std::array<Dac::Value, Channels> _nextValues;
 };
@@ -3,12 +3,19 @@
 #include "Config.h"
 #include "MidiUtils.h"
 
+#include "model/FileManager.h"
+
 #include "core/Debug.h"
 #include "core/midi/MidiMessage.h"
+#include "core/profiler/Profiler.h"
+
+#include "drivers/HighResolutionTimer.h"
 
 #include "os/os.h"
 
-Engine::Engine(Model &model, ClockTimer &clockTimer, Adc &adc, Dac &dac, Dio &dio, GateOutput &gateOutput, Midi &midi, UsbMidi &usbMidi) :
+PROFILER_INTERVAL(engineUpdate, "engine update")
+
+Engine::Engine(Model &model, ClockTimer &clockTimer, OutputTimer &outputTimer, Adc &adc, Dac &dac, Dio &dio, GateOutput &gateOutput, Midi &midi, UsbMidi &usbMidi) :
     _model(model),
     _project(model.project()),
     _dio(dio),
@@ -16,7 +23,8 @@ Engine::Engine(Model &model, ClockTimer &clockTimer, Adc &adc, Dac &dac, Dio &di
     _midi(midi),
     _usbMidi(usbMidi),
     _cvInput(adc),
-    _cvOutput(dac, model.settings().calibration()),
+    _cvOutput(model.settings().calibration()),
+    _outputScheduler(outputTimer, gateOutput, dac),
     _clock(clockTimer),
     _midiOutputEngine(*this, model),
     _routingEngine(*this, model)
@@ -33,6 +41,7 @@ Engine::Engine(Model &model, ClockTimer &clockTimer, Adc &adc, Dac &dac, Dio &di
 void Engine::init() {
     _cvInput.init();
     _cvOutput.init();
+    _outputScheduler.init(_cvOutput);
     _clock.init();
 
     initClock();
@@ -56,6 +65,8 @@ void Engine::update() {
         return;
     }
 
+    PROFILER_INTERVAL_SCOPE(engineUpdate)
+
     uint32_t systemTicks = os::ticks();
     float dt = (0.001f * (systemTicks - _lastSystemTicks)) / os::time::ms(1);
     _lastSystemTicks = systemTicks;
@@ -81,8 +92,7 @@ void Engine::update() {
 
         _cvInput.update();
         updateOverrides();
-        _cvOutput.update();
-        _gateOutput.update();
+        scheduleOutputs(HighResolutionTimer::us());
         return;
     }
 
@@ -110,6 +120,11 @@ void Engine::update() {
         }
     }
 
+    // apply cued project right away when stopped, otherwise at the next measure boundary
+    if (!_state.running() && FileManager::projectCued()) {
+        applyProjectCue();
+    }
+
     // update tempo
     _nudgeTempo.update(dt);
     _clock.setMasterBpm(_project.tempo() * (1.f + _nudgeTempo.strength() * 0.1f));
@@ -133,15 +148,24 @@ void Engine::update() {
     _routingEngine.update();
 
     uint32_t tick;
-    while (_clock.checkTick(&tick)) {
+    uint32_t tickTime;
+    while (_clock.checkTick(&tick, &tickTime)) {
         _tick = tick;
 
+        if (FileManager::projectCued() && tick % measureDivisor() == 0) {
+            applyProjectCue();
+        }
+
         // update play state
         updatePlayState(true);
 
         // tick track engines
         for (size_t trackIndex = 0; trackIndex < CONFIG_TRACK_COUNT; ++trackIndex) {
             auto &trackEngine = _trackEngines[trackIndex];
+            // skip track engines that have no work scheduled on this tick
+            if (tick < trackEngine->nextTick()) {
+                continue;
+            }
             uint32_t result = trackEngine->tick(tick);
             // update track outputs and routings if tick results in updating the track's CV output
             if (result &= TrackEngine::TickResult::CvUpdate && _trackUpdateReducers[trackIndex].update()) {
@@ -156,6 +180,11 @@ void Engine::update() {
         if (tick == 0) {
             _midiOutputEngine.update(true);
         }
+
+        // schedule outputs at the time of the tick
+        updateTrackOutputs();
+        updateOverrides();
+        scheduleOutputs(tickTime);
     }
 
     for (auto trackEngine : _trackEngines) {
@@ -168,8 +197,7 @@ void Engine::update() {
     updateOverrides();
 
     // update cv/gate outputs
-    _cvOutput.update();
-    _gateOutput.update();
+    scheduleOutputs(HighResolutionTimer::us());
 }
 
 void Engine::lock() {
@@ -373,10 +401,17 @@ Engine::Stats Engine::stats() const {
     return {
         .uptime = os::ticks() / os::time::ms(1000),
         .midiRxOverflow = _midi.rxOverflow(),
-        .usbMidiRxOverflow = _usbMidi.rxOverflow()
+        .usbMidiRxOverflow = _usbMidi.rxOverflow(),
+        .usbMidiTxOverflow = _usbMidi.txOverflow(),
+        .midiReceiveDropped = _midiReceiveDropped,
+        .outputs = _outputScheduler.stats()
     };
 }
 
+void Engine::resetStats() {
+    _outputScheduler.resetStats();
+}
+
 void Engine::onClockOutput(const Clock::OutputState &state) {
     _dio.clockOutput.set(state.clock);
     switch (_project.clockSetup().clockOutputMode()) {
@@ -404,9 +439,15 @@ void Engine::onClockMidi(uint8_t data) {
 }
 
 void Engine::updateTrackSetups() {
+    std::array<bool, CONFIG_TRACK_COUNT> linkSources;
+    linkSources.fill(false);
+
     for (int trackIndex = 0; trackIndex < CONFIG_TRACK_COUNT; ++trackIndex) {
         auto &track = _project.track(trackIndex);
         int linkTrack = track.linkTrack();
+        if (linkTrack >= 0) {
+            linkSources[linkTrack] = true;
+        }
         const TrackEngine *linkedTrackEngine = linkTrack >= 0 ? &trackEngine(linkTrack) : nullptr;
         FixedStringBuilder<16> str("TRACK %d", trackIndex+1);
        
@@ -443,6 +484,28 @@ void Engine::updateTrackSetups() {
         // update linked track engine
         _trackEngines[trackIndex]->setLinkedTrackEngine(linkedTrackEngine);
     }
+
+    for (int trackIndex = 0; trackIndex < CONFIG_TRACK_COUNT; ++trackIndex) {
+        _trackEngines[trackIndex]->setLinkSource(linkSources[trackIndex]);
+    }
+}
+
+void Engine::applyProjectCue() {
+    // the project is being written by the file task, keep the cue until the next measure boundary
+    if (_project.saveStateActive()) {
+        return;
+    }
+
+    if (FileManager::applyCuedProject(_project)) {
+        // keep the clock running and restart all tracks with the new project
+        updateTrackSetups();
+        for (auto trackEngine : _trackEngines) {
+            trackEngine->resetRandom();
+            trackEngine->changePattern();
+            trackEngine->restart();
+        }
+        _projectCueApplied = true;
+    }
 }
 
 void Engine::updateTrackOutputs() {
@@ -457,20 +520,35 @@ void Engine::updateTrackOutputs() {
         trackCvIndex[trackIndex] = 0;
     }
 
-    for (int trackIndex = 0; trackIndex < CONFIG_TRACK_COUNT; ++trackIndex) {
-        int gateOutputTrack = gateOutputTracks[trackIndex];
+    for (int channelIndex = 0; channelIndex < CONFIG_CHANNEL_COUNT; ++channelIndex) {
+        int gateOutputTrack = gateOutputTracks[channelIndex];
         if (!_gateOutputOverride) {
-            _gateOutput.setGate(trackIndex, _trackEngines[gateOutputTrack]->gateOutput(trackGateIndex[gateOutputTrack]++));
+            if (_trackEngines[gateOutputTrack]->gateOutput(trackGateIndex[gateOutputTrack]++)) {
+                _gates |= (1 << channelIndex);
+            } else {
+                _gates &= ~(1 << channelIndex);
+            }
         }
-        int cvOutputTrack = cvOutputTracks[trackIndex];
+        int cvOutputTrack = cvOutputTracks[channelIndex];
         if (!_cvOutputOverride) {
-            _cvOutput.setChannel(trackIndex, _trackEngines[cvOutputTrack]->cvOutput(trackCvIndex[cvOutputTrack]++));
+            const auto &trackEngine = _trackEngines[cvOutputTrack];
+            int index = trackCvIndex[cvOutputTrack]++;
+            _cvOutput.setChannel(channelIndex, trackEngine->cvOutput(index));
+            _cvOutput.setNextChannel(channelIndex, trackEngine->cvOutputNext(index));
         }
     }
 }
 
+void Engine::scheduleOutputs(uint32_t time) {
+    _cvOutput.update();
+    // streamed outputs reach their next value after one tick
+    uint32_t rampDuration = std::min(_clock.tickDuration() * 1e6f, 65535.f);
+    _outputScheduler.schedule(time, _gates, _cvOutput, rampDuration);
+}
+
 void Engine::reset() {
     for (auto trackEngine : _trackEngines) {
+        trackEngine->resetRandom();
         trackEngine->reset();
     }
 
@@ -653,7 +731,7 @@ void Engine::updatePlayState(bool ticked) {
 void Engine::updateOverrides() {
     // overrides
     if (_gateOutputOverride) {
-        _gateOutput.setGates(_gateOutputOverrideValue);
+        _gates = _gateOutputOverrideValue;
     }
     if (_cvOutputOverride) {
         for (size_t i = 0; i < _cvOutputOverrideValues.size(); ++i) {
@@ -682,6 +760,8 @@ void Engine::receiveMidi() {
         }
     }
 
+    updateMidiTrackMasks();
+
     // receive MIDI messages from ports
     MidiMessage message;
     while (_midi.recv(&message)) {
@@ -733,7 +813,7 @@ void Engine::receiveMidi(MidiPort port, uint8_t cable, const MidiMessage &messag
     }
 
     // let midi learn inspect messages (except from virtual CV/Gate messages)
-    if (port != MidiPort::CvGate) {
+    if (_midiLearn.isActive() && port != MidiPort::CvGate) {
         _midiLearn.receiveMidi(port, message);
     }
 
@@ -745,8 +825,13 @@ void Engine::receiveMidi(MidiPort port, uint8_t cable, const MidiMessage &messag
     // let track engines consume messages (only MIDI/CV tracks)
     // allow all tracks to receive messages even if one of them consumes it
     bool consumed = false;
-    for (auto trackEngine : _trackEngines) {
-        consumed |= trackEngine->receiveMidi(port, message);
+    if (int(port) < int(Types::MidiPort::Last)) {
+        Types::TrackBits trackMask = _midiTrackMasks[int(port)][message.channel()];
+        for (int trackIndex = 0; trackMask; ++trackIndex, trackMask >>= 1) {
+            if (trackMask & 1) {
+                consumed |= _trackEngines[trackIndex]->receiveMidi(port, message);
+            }
+        }
     }
     if (consumed) {
         return;
@@ -764,6 +849,26 @@ void Engine::receiveMidi(MidiPort port, uint8_t cable, const MidiMessage &messag
     monitorMidi(message);
 }
 
+void Engine::updateMidiTrackMasks() {
+    for (auto &channelMasks : _midiTrackMasks) {
+        channelMasks.fill(0);
+    }
+
+    for (int trackIndex = 0; trackIndex < CONFIG_TRACK_COUNT; ++trackIndex) {
+        const auto &track = _project.track(trackIndex);
+        if (track.trackMode() != Track::TrackMode::MidiCv || _trackEngines[trackIndex]->trackMode() != Track::TrackMode::MidiCv) {
+            continue;
+        }
+        const auto &source = track.midiCvTrack().source();
+        auto &channelMasks = _midiTrackMasks[int(source.port())];
+        for (int channel = 0; channel < 16; ++channel) {
+            if (source.isOmni() || source.channel() == channel) {
+                channelMasks[channel] |= Types::TrackBits(1) << trackIndex;
+            }
+        }
+    }
+}
+
 void Engine::monitorMidi(const MidiMessage &message) {
     // helper to send monitor message to a track engine
     auto sendMidi = [this] (int trackIndex, const MidiMessage &message) {
@@ -895,6 +1000,18 @@ void Engine::updateClockSetup() {
         break;
     }
 
+    // Configure slave synchronization
+    switch (clockSetup.slaveSync()) {
+    case ClockSetup::SlaveSync::Pulse:
+        _clock.setSlaveSync(Clock::SlaveSync::Pulse, clockSetup.slaveResponse());
+        break;
+    case ClockSetup::SlaveSync::Pll:
+        _clock.setSlaveSync(Clock::SlaveSync::Pll, clockSetup.slaveResponse());
+        break;
+    case ClockSetup::SlaveSync::Last:
+        break;
+    }
+
     // Configure clock slaves
     _clock.slaveConfigure(ClockSourceExternal, clockSetup.clockInputDivisor() * (CONFIG_PPQN / CONFIG_SEQUENCE_PPQN), true);
     _clock.slaveConfigure(ClockSourceMidi, CONFIG_PPQN / 24, clockSetup.midiRx());
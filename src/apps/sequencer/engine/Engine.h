@@ -10,6 +10,7 @@
 #include "MidiCvTrackEngine.h"
 #include "CvInput.h"
 #include "CvOutput.h"
+#include "OutputScheduler.h"
 #include "RoutingEngine.h"
 #include "MidiOutputEngine.h"
 #include "MidiPort.h"
@@ -25,6 +26,7 @@
 #include "drivers/Dio.h"
 #include "drivers/GateOutput.h"
 #include "drivers/Midi.h"
+#include "drivers/OutputTimer.h"
 #include "drivers/UsbMidi.h"
 
 #include <array>
@@ -55,9 +57,12 @@ public:
         uint32_t uptime;
         uint32_t midiRxOverflow;
         uint32_t usbMidiRxOverflow;
+        uint32_t usbMidiTxOverflow;
+        uint32_t midiReceiveDropped;
+        OutputScheduler::Stats outputs;
     };
 
-    Engine(Model &model, ClockTimer &clockTimer, Adc &adc, Dac &dac, Dio &dio, GateOutput &gateOutput, Midi &midi, UsbMidi &usbMidi);
+    Engine(Model &model, ClockTimer &clockTimer, OutputTimer &outputTimer, Adc &adc, Dac &dac, Dio &dio, GateOutput &gateOutput, Midi &midi, UsbMidi &usbMidi);
 
     void init();
     void update();
@@ -149,8 +154,21 @@ public:
 
     bool trackEnginesConsistent() const;
 
+    // returns true once after a cued project was applied, watchers of the project are notified from the ui task
+    bool checkProjectCueApplied() {
+        if (!_projectCueApplied) {
+            return false;
+        }
+        _projectCueApplied = false;
+        return true;
+    }
+
     bool sendMidi(MidiPort port, uint8_t cable, const MidiMessage &message);
+    // number of messages that can be sent to usb midi without overflowing the transmit queue
+    uint32_t usbMidiTxAvailable() const { return _usbMidi.txAvailable(); }
     void setMidiReceiveHandler(MidiReceiveHandler handler) { _midiReceiveHandler = handler; }
+    // called by the midi receive handler when it had to drop a message (only from within the handler)
+    void midiReceiveDropped() { ++_midiReceiveDropped; }
     void setUsbMidiConnectHandler(UsbMidiConnectHandler handler) { _usbMidiConnectHandler = handler; }
     void setUsbMidiDisconnectHandler(UsbMidiDisconnectHandler handler) { _usbMidiDisconnectHandler = handler; }
 
@@ -159,6 +177,7 @@ public:
     void setMessageHandler(MessageHandler handler);
 
     Stats stats() const;
+    void resetStats();
 
 private:
     // Clock::Listener
@@ -167,15 +186,18 @@ private:
 
     void updateTrackSetups();
     void updateTrackOutputs();
+    void scheduleOutputs(uint32_t time);
     void reset();
     void updatePlayState(bool ticked);
     void updateOverrides();
+    void applyProjectCue();
 
     void usbMidiConnect(uint16_t vendorId, uint16_t productId);
     void usbMidiDisconnect();
 
     void receiveMidi();
     void receiveMidi(MidiPort port, uint8_t cable, const MidiMessage &message);
+    void updateMidiTrackMasks();
     void monitorMidi(const MidiMessage &message);
 
     void initClock();
@@ -192,6 +214,8 @@ private:
 
     CvInput _cvInput;
     CvOutput _cvOutput;
+    uint8_t _gates = 0;
+    OutputScheduler _outputScheduler;
 
     Clock _clock;
     TapTempo _tapTempo;
@@ -206,6 +230,10 @@ private:
     RoutingEngine _routingEngine;
     MidiLearn _midiLearn;
     MidiReceiveHandler _midiReceiveHandler;
+    uint32_t _midiReceiveDropped = 0;
+
+    // tracks receiving midi messages by port and channel
+    std::array<std::array<Types::TrackBits, 16>, int(Types::MidiPort::Last)> _midiTrackMasks;
     UsbMidiConnectHandler _usbMidiConnectHandler;
     UsbMidiDisconnectHandler _usbMidiDisconnectHandler;
 
@@ -219,6 +247,8 @@ private:
     volatile uint32_t _requestSuspend = 0;
     volatile uint32_t _suspended = 0;
 
+    volatile bool _projectCueApplied = false;
+
     uint32_t _tick = 0;
 
     uint32_t _lastSystemTicks = 0;
@@ -3,11 +3,14 @@
 #include "Slide.h"
 #include "MidiUtils.h"
 
+#include "core/profiler/Profiler.h"
+
 #include "os/os.h"
 
 #include <cmath>
 #include <cinttypes>
 
+PROFILER_INTERVAL(midiCvTrackTick, "midi/cv track tick")
 
 void MidiCvTrackEngine::reset() {
     _arpeggiatorEnabled = false;
@@ -22,6 +25,8 @@ void MidiCvTrackEngine::restart() {
 }
 
 TrackEngine::TickResult MidiCvTrackEngine::tick(uint32_t tick) {
+    PROFILER_INTERVAL_SCOPE(midiCvTrackTick)
+
     if (_arpeggiatorEnabled) {
         tickArpeggiator(tick);
     }
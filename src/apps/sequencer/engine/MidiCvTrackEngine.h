@@ -10,7 +10,7 @@ public:
     MidiCvTrackEngine(Engine &engine, const Model &model, Track &track, const TrackEngine *linkedTrackEngine) :
         TrackEngine(engine, model, track, linkedTrackEngine),
         _midiCvTrack(track.midiCvTrack()),
-        _arpeggiatorEngine(_midiCvTrack.arpeggiator())
+        _arpeggiatorEngine(_midiCvTrack.arpeggiator(), _rng)
     {
         reset();
     }
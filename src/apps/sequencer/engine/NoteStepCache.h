@@ -0,0 +1,77 @@
+#pragma once
+
+#include "Config.h"
+
+#include "model/NoteSequence.h"
+#include "model/Scale.h"
+#include "model/Types.h"
+
+#include <array>
+
+#include <cstdint>
+
+// Cache of the deterministic parts of note step evaluation.
+// Holds the resolved note voltage and the decoded step condition in flat per-step arrays, so triggering a step
+// only needs to do the random draws. Each entry keeps a copy of the packed step data it was built from and is
+// rebuilt lazily when the step was edited. Changing sequence, scale, root note, octave or transpose clears all entries.
+class NoteStepCache {
+public:
+    static_assert(CONFIG_STEP_COUNT <= 64, "valid mask too small");
+
+    // validates the cache against the current evaluation settings
+    void setup(const NoteSequence &sequence, const Scale &scale, int rootNote, int octave, int transpose) {
+        if (&sequence != _sequence || &scale != _scale || scale.revision() != _scaleRevision ||
+            rootNote != _rootNote || octave != _octave || transpose != _transpose) {
+            _sequence = &sequence;
+            _scale = &scale;
+            _scaleRevision = scale.revision();
+            _rootNote = rootNote;
+            _octave = octave;
+            _transpose = transpose;
+            _transposition = octave * scale.notesPerOctave() + transpose;
+            _rootVolts = (scale.isChromatic() ? rootNote : 0) * (1.f / 12.f);
+            _valid = 0;
+        }
+    }
+
+    // makes sure the entry of the given step is up to date
+    void resolve(int index) {
+        const auto &step = _sequence->step(index);
+        if (!(_valid & (uint64_t(1) << index)) || !(_steps[index] == step)) {
+            build(index, step);
+        }
+    }
+
+    // transposition in scale notes
+    int transposition() const { return _transposition; }
+
+    // voltage of a (transposed) note, used for notes with variation
+    float noteVolts(int note) const { return _scale->noteToVolts(note) + _rootVolts; }
+
+    // voltage of the step note without variation
+    float stepVolts(int index) const { return _volts[index]; }
+
+    const Types::ConditionLoop &stepConditionLoop(int index) const { return _conditionLoops[index]; }
+
+private:
+    void build(int index, const NoteSequence::Step &step) {
+        _steps[index] = step;
+        _volts[index] = noteVolts(step.note() + _transposition);
+        _conditionLoops[index] = Types::conditionLoop(step.condition());
+        _valid |= uint64_t(1) << index;
+    }
+
+    const NoteSequence *_sequence = nullptr;
+    const Scale *_scale = nullptr;
+    uint32_t _scaleRevision = 0;
+    int _rootNote = 0;
+    int _octave = 0;
+    int _transpose = 0;
+    int _transposition = 0;
+    float _rootVolts = 0.f;
+
+    uint64_t _valid = 0;
+    std::array<NoteSequence::Step, CONFIG_STEP_COUNT> _steps;
+    std::array<float, CONFIG_STEP_COUNT> _volts;
+    std::array<Types::ConditionLoop, CONFIG_STEP_COUNT> _conditionLoops;
+};
@@ -8,24 +8,24 @@
 #include "core/Debug.h"
 #include "core/utils/Random.h"
 #include "core/math/Math.h"
+#include "core/profiler/Profiler.h"
 
 #include "model/NoteSequence.h"
 #include "model/Scale.h"
 #include "ui/MatrixMap.h"
 #include <climits>
 #include <iostream>
-#include <ctime>
 
-static Random rng;
+PROFILER_INTERVAL(noteTrackTick, "note track tick")
 
 // evaluate if step gate is active
-static bool evalStepGate(const NoteSequence::Step &step, int probabilityBias) {
+static bool evalStepGate(Random &rng, const NoteSequence::Step &step, int probabilityBias) {
     int probability = clamp(step.gateProbability() + probabilityBias, -1, NoteSequence::GateProbability::Max);
     return step.gate() && int(rng.nextRange(NoteSequence::GateProbability::Range)) <= probability;
 }
 
-// evaluate step condition
-static bool evalStepCondition(const NoteSequence::Step &step, int iteration, bool fill, bool &prevCondition) {
+// evaluate step condition (loop conditions are decoded by the step cache)
+static bool evalStepCondition(const NoteSequence::Step &step, const Types::ConditionLoop &loop, int iteration, bool fill, bool &prevCondition) {
     auto condition = step.condition();
     switch (condition) {
     case Types::Condition::Off:                                         return true;
@@ -38,7 +38,6 @@ static bool evalStepCondition(const NoteSequence::Step &step, int iteration, boo
     default:
         int index = int(condition);
         if (index >= int(Types::Condition::Loop) && index < int(Types::Condition::Last)) {
-            auto loop = Types::conditionLoop(condition);
             prevCondition = iteration % loop.base == loop.offset;
             if (loop.invert) prevCondition = !prevCondition;
             return prevCondition;
@@ -48,13 +47,13 @@ static bool evalStepCondition(const NoteSequence::Step &step, int iteration, boo
 }
 
 // evaluate step retrigger count
-static int evalStepRetrigger(const NoteSequence::Step &step, int probabilityBias) {
+static int evalStepRetrigger(Random &rng, const NoteSequence::Step &step, int probabilityBias) {
     int probability = clamp(step.retriggerProbability() + probabilityBias, -1, NoteSequence::RetriggerProbability::Max);
     return int(rng.nextRange(NoteSequence::RetriggerProbability::Range)) <= probability ? step.retrigger() + 1 : 1;
 }
 
 // evaluate step length
-static int evalStepLength(const NoteSequence::Step &step, int lengthBias) {
+static int evalStepLength(Random &rng, const NoteSequence::Step &step, int lengthBias) {
     int length = NoteSequence::Length::clamp(step.length() + lengthBias) + 1;
     int probability = step.lengthVariationProbability();
     if (int(rng.nextRange(NoteSequence::LengthVariationProbability::Range)) <= probability) {
@@ -73,7 +72,7 @@ static int evalTransposition(const Scale &scale, int octave, int transpose) {
 }
 
 // evaluate note voltage
-static float evalStepNote(const NoteSequence::Step &step, int probabilityBias, const Scale &scale, int rootNote, int octave, int transpose, bool useVariation = true) {
+static float evalStepNote(Random &rng, const NoteSequence::Step &step, int probabilityBias, const Scale &scale, int rootNote, int octave, int transpose, bool useVariation = true) {
     int note = step.note() + evalTransposition(scale, octave, transpose);
     int probability = clamp(step.noteVariationProbability() + probabilityBias, -1, NoteSequence::NoteVariationProbability::Max);
     if (useVariation && int(rng.nextRange(NoteSequence::NoteVariationProbability::Range)) <= probability) {
@@ -86,8 +85,26 @@ static float evalStepNote(const NoteSequence::Step &step, int probabilityBias, c
     return scale.noteToVolts(note) + (scale.isChromatic() ? rootNote : 0) * (1.f / 12.f);
 }
 
+// evaluate note voltage using the step cache, only notes with variation are resolved here
+static float evalStepNote(Random &rng, const NoteSequence::Step &step, int probabilityBias, const NoteStepCache &cache, int stepIndex) {
+    int note = step.note() + cache.transposition();
+    int probability = clamp(step.noteVariationProbability() + probabilityBias, -1, NoteSequence::NoteVariationProbability::Max);
+    if (int(rng.nextRange(NoteSequence::NoteVariationProbability::Range)) <= probability) {
+        int offset = step.noteVariationRange() == 0 ? 0 : rng.nextRange(std::abs(step.noteVariationRange()) + 1);
+        if (step.noteVariationRange() < 0) {
+            offset = -offset;
+        }
+        int variedNote = NoteSequence::Note::clamp(note + offset);
+        if (variedNote != note) {
+            return cache.noteVolts(variedNote);
+        }
+    }
+    return cache.stepVolts(stepIndex);
+}
+
 void NoteTrackEngine::reset() {
     _freeRelativeTick = 0;
+    _freeLastTick = 0;
     _sequenceState.reset();
     _currentStep = -1;
     _prevCondition = false;
@@ -101,15 +118,20 @@ void NoteTrackEngine::reset() {
     _recordHistory.clear();
 
     changePattern();
+    lockRandom(_sequence->seed());
 }
 
 void NoteTrackEngine::restart() {
     _freeRelativeTick = 0;
     _sequenceState.reset();
     _currentStep = -1;
+    lockRandom(_sequence->seed());
+    invalidateSchedule();
 }
 
 TrackEngine::TickResult NoteTrackEngine::tick(uint32_t tick) {
+    PROFILER_INTERVAL_SCOPE(noteTrackTick)
+
     ASSERT(_sequence != nullptr, "invalid sequence");
     const auto &sequence = *_sequence;
     const auto *linkData = _linkedTrackEngine ? _linkedTrackEngine->linkData() : nullptr;
@@ -138,7 +160,7 @@ TrackEngine::TickResult NoteTrackEngine::tick(uint32_t tick) {
         switch (_noteTrack.playMode()) {
         case Types::PlayMode::Aligned:
             if (relativeTick % divisor == 0) {
-                _sequenceState.advanceAligned(relativeTick / divisor, sequence.runMode(), sequence.firstStep(), sequence.lastStep(), rng);
+                _sequenceState.advanceAligned(relativeTick / divisor, sequence.runMode(), sequence.firstStep(), sequence.lastStep(), _rng);
                 recordStep(tick, divisor);
                 triggerStep(tick, divisor);
                 
@@ -147,12 +169,20 @@ TrackEngine::TickResult NoteTrackEngine::tick(uint32_t tick) {
                         sequence.runMode(),
                         sequence.firstStep(),
                         sequence.lastStep(),
-                        rng
+                        _rng
                     );
                 triggerStep(tick + divisor, divisor, true);
             }
             break;
         case Types::PlayMode::Free:
+            // account for ticks skipped by the scheduler
+            if (_freeRelativeTick > 0) {
+                _freeRelativeTick += tick - _freeLastTick - 1;
+                if (_freeRelativeTick >= divisor) {
+                    _freeRelativeTick = 0;
+                }
+            }
+            _freeLastTick = tick;
             relativeTick = _freeRelativeTick;
             if (++_freeRelativeTick >= divisor) {
                 _freeRelativeTick = 0;
@@ -160,7 +190,7 @@ TrackEngine::TickResult NoteTrackEngine::tick(uint32_t tick) {
             if (relativeTick == 0) {
 
                 if (_currentStageRepeat == 1) {
-                     _sequenceState.advanceFree(sequence.runMode(), sequence.firstStep(), sequence.lastStep(), rng);
+                     _sequenceState.advanceFree(sequence.runMode(), sequence.firstStep(), sequence.lastStep(), _rng);
                 }
 
                 recordStep(tick, divisor);
@@ -214,6 +244,8 @@ TrackEngine::TickResult NoteTrackEngine::tick(uint32_t tick) {
         _cvQueue.pop();
     }
 
+    scheduleNextTick(tick, linkData != nullptr);
+
     return result;
 }
 
@@ -222,6 +254,13 @@ void NoteTrackEngine::update(float dt) {
     bool recording = _engine.state().recording();
 
     const auto &sequence = *_sequence;
+
+    // reschedule if sequence timing was edited
+    if (sequenceDivisor() != _scheduleDivisor ||
+        sequenceResetDivisor() != _scheduleResetDivisor ||
+        _noteTrack.playMode() != _schedulePlayMode) {
+        invalidateSchedule();
+    }
     const auto &scale = sequence.selectedScale(_model.project().scale());
     int rootNote = sequence.selectedRootNote(_model.project().rootNote());
     int octave = _noteTrack.octave();
@@ -277,7 +316,7 @@ void NoteTrackEngine::update(float dt) {
 
     if (stepMonitoring) {
         const auto &step = sequence.step(_monitorStepIndex);
-        setOverride(evalStepNote(step, 0, scale, rootNote, octave, transpose, false));
+        setOverride(evalStepNote(_rng, step, 0, scale, rootNote, octave, transpose, false));
     } else if (liveMonitoring && _recordHistory.isNoteActive()) {
         int note = noteFromMidiNote(_recordHistory.activeNote()) + evalTransposition(scale, octave, transpose);
         setOverride(scale.noteToVolts(note) + (scale.isChromatic() ? rootNote : 0) * (1.f / 12.f));
@@ -293,14 +332,20 @@ void NoteTrackEngine::update(float dt) {
 }
 
 void NoteTrackEngine::changePattern() {
-    _sequence = &_noteTrack.sequence(pattern());
+    auto sequence = &_noteTrack.sequence(pattern());
+    // also called for mute/solo/fill requests, only reseed when switching to another pattern
+    if (sequence != _sequence) {
+        lockRandom(sequence->seed());
+    }
+    _sequence = sequence;
     _fillSequence = &_noteTrack.sequence(std::min(pattern() + 1, CONFIG_PATTERN_COUNT - 1));
+    invalidateSchedule();
 }
 
 void NoteTrackEngine::monitorMidi(uint32_t tick, const MidiMessage &message) {
     _recordHistory.write(tick, message);
 
-    if (_engine.recording() && _model.project().recordMode() == Types::RecordMode::StepRecord) {
+    if (_engine.recording() && _model.project().recordMode() == Types::RecordMode::StepRecord && !_model.project().saveStateActive()) {
         _stepRecorder.process(message, *_sequence, [this] (int midiNote) { return noteFromMidiNote(midiNote); });
     }
 }
@@ -322,7 +367,7 @@ void NoteTrackEngine::triggerStep(uint32_t tick, uint32_t divisor, bool forNextS
     int octave = _noteTrack.octave();
     int transpose = _noteTrack.transpose();
     int rotate = _noteTrack.rotate();
-    bool fillStep = fill() && (rng.nextRange(100) < uint32_t(fillAmount()));
+    bool fillStep = fill() && (_rng.nextRange(100) < uint32_t(fillAmount()));
     bool useFillGates = fillStep && _noteTrack.fillMode() == NoteTrack::FillMode::Gates;
     bool useFillSequence = fillStep && _noteTrack.fillMode() == NoteTrack::FillMode::NextPattern;
     bool useFillCondition = fillStep && _noteTrack.fillMode() == NoteTrack::FillMode::Condition;
@@ -345,12 +390,20 @@ void NoteTrackEngine::triggerStep(uint32_t tick, uint32_t divisor, bool forNextS
 
     const auto &step = evalSequence.step(stepIndex);
 
+    _stepCache.setup(
+        evalSequence,
+        evalSequence.selectedScale(_model.project().scale()),
+        evalSequence.selectedRootNote(_model.project().rootNote()),
+        octave, transpose
+    );
+    _stepCache.resolve(stepIndex);
+
     int gateOffset = ((int) divisor * step.gateOffset()) / (NoteSequence::GateOffset::Max + 1);
     uint32_t stepTick = (int) tick + gateOffset;
 
-    bool stepGate = evalStepGate(step, _noteTrack.gateProbabilityBias()) || useFillGates;
+    bool stepGate = evalStepGate(_rng, step, _noteTrack.gateProbabilityBias()) || useFillGates;
     if (stepGate) {
-        stepGate = evalStepCondition(step, _sequenceState.iteration(), useFillCondition, _prevCondition);
+        stepGate = evalStepCondition(step, _stepCache.stepConditionLoop(stepIndex), _sequenceState.iteration(), useFillCondition, _prevCondition);
     }
     switch (step.stageRepeatMode()) {
         case NoteSequence::StageRepeatMode::Each:
@@ -374,8 +427,7 @@ void NoteTrackEngine::triggerStep(uint32_t tick, uint32_t divisor, bool forNextS
             stepGate = stepGate && (_currentStageRepeat - 1) % 3 == 0;
             break;
         case NoteSequence::StageRepeatMode::Random:
-                srand((unsigned int)time(NULL));
-                int rndMode = 0 + ( std::rand() % ( 6 - 0 + 1 ) );
+                int rndMode = _rng.nextRange(7);
                 switch (rndMode) {
                     case 0:
                         break;
@@ -403,8 +455,8 @@ void NoteTrackEngine::triggerStep(uint32_t tick, uint32_t divisor, bool forNextS
     }
 
     if (stepGate) {
-        uint32_t stepLength = (divisor * evalStepLength(step, _noteTrack.lengthBias())) / NoteSequence::Length::Range;
-        int stepRetrigger = evalStepRetrigger(step, _noteTrack.retriggerProbabilityBias());
+        uint32_t stepLength = (divisor * evalStepLength(_rng, step, _noteTrack.lengthBias())) / NoteSequence::Length::Range;
+        int stepRetrigger = evalStepRetrigger(_rng, step, _noteTrack.retriggerProbabilityBias());
         if (stepRetrigger > 1) {
             uint32_t retriggerLength = divisor / stepRetrigger;
             uint32_t retriggerOffset = 0;
@@ -420,9 +472,7 @@ void NoteTrackEngine::triggerStep(uint32_t tick, uint32_t divisor, bool forNextS
     }
 
     if (stepGate || _noteTrack.cvUpdateMode() == NoteTrack::CvUpdateMode::Always) {
-        const auto &scale = evalSequence.selectedScale(_model.project().scale());
-        int rootNote = evalSequence.selectedRootNote(_model.project().rootNote());
-        _cvQueue.push({ Groove::applySwing(stepTick, swing()), evalStepNote(step, _noteTrack.noteProbabilityBias(), scale, rootNote, octave, transpose), step.slide() });
+        _cvQueue.push({ Groove::applySwing(stepTick, swing()), evalStepNote(_rng, step, _noteTrack.noteProbabilityBias(), _stepCache, stepIndex), step.slide() });
     }
 }
 
@@ -430,11 +480,69 @@ void NoteTrackEngine::triggerStep(uint32_t tick, uint32_t divisor) {
     triggerStep(tick, divisor, false);
 }
 
+uint32_t NoteTrackEngine::sequenceDivisor() const {
+    return _sequence->divisor() * (CONFIG_PPQN / CONFIG_SEQUENCE_PPQN);
+}
+
+uint32_t NoteTrackEngine::sequenceResetDivisor() const {
+    return _sequence->resetMeasure() * _engine.measureDivisor();
+}
+
+void NoteTrackEngine::scheduleNextTick(uint32_t tick, bool linked) {
+    uint32_t divisor = sequenceDivisor();
+    uint32_t resetDivisor = sequenceResetDivisor();
+    auto playMode = _noteTrack.playMode();
+
+    _scheduleDivisor = divisor;
+    _scheduleResetDivisor = resetDivisor;
+    _schedulePlayMode = playMode;
+
+    // linked tracks follow the link data of another track and link sources have to keep it current
+    if (linked || isLinkSource()) {
+        _nextTick = tick + 1;
+        return;
+    }
+
+    // next step
+    uint32_t relativeTick = resetDivisor == 0 ? tick : tick % resetDivisor;
+    uint32_t nextTick = UINT32_MAX;
+    switch (playMode) {
+    case Types::PlayMode::Aligned:
+        nextTick = tick + divisor - relativeTick % divisor;
+        break;
+    case Types::PlayMode::Free:
+        nextTick = tick + (_freeRelativeTick == 0 ? 1 : divisor - _freeRelativeTick);
+        break;
+    case Types::PlayMode::Last:
+        break;
+    }
+
+    // next reset measure
+    if (resetDivisor != 0) {
+        nextTick = std::min(nextTick, tick + resetDivisor - relativeTick);
+    }
+
+    // next queued gate/cv event
+    if (!_gateQueue.empty()) {
+        nextTick = std::min(nextTick, _gateQueue.front().tick);
+    }
+    if (!_cvQueue.empty()) {
+        nextTick = std::min(nextTick, _cvQueue.front().tick);
+    }
+
+    _nextTick = std::max(nextTick, tick + 1);
+}
+
 void NoteTrackEngine::recordStep(uint32_t tick, uint32_t divisor) {
     if (!_engine.state().recording() || _model.project().recordMode() == Types::RecordMode::StepRecord || _sequenceState.prevStep() < 0) {
         return;
     }
 
+    // do not modify sequences while the project is being saved
+    if (_model.project().saveStateActive()) {
+        return;
+    }
+
     bool stepWritten = false;
 
     auto writeStep = [this, divisor, &stepWritten] (int stepIndex, int note, int lengthTicks) {
@@ -5,6 +5,7 @@
 #include "SortedQueue.h"
 #include "Groove.h"
 #include "RecordHistory.h"
+#include "NoteStepCache.h"
 #include "model/NoteSequence.h"
 #include "StepRecorder.h"
 
@@ -50,6 +51,9 @@ private:
     void triggerStep(uint32_t tick, uint32_t divisor, bool nextStep);
     void triggerStep(uint32_t tick, uint32_t divisor);
     void recordStep(uint32_t tick, uint32_t divisor);
+    uint32_t sequenceDivisor() const;
+    uint32_t sequenceResetDivisor() const;
+    void scheduleNextTick(uint32_t tick, bool linked);
     int noteFromMidiNote(uint8_t midiNote) const;
 
     bool fill() const {
@@ -60,10 +64,12 @@ private:
 
     TrackLinkData _linkData;
 
-    NoteSequence *_sequence;
+    NoteSequence *_sequence = nullptr;
     const NoteSequence *_fillSequence;
+    NoteStepCache _stepCache;
 
     uint32_t _freeRelativeTick;
+    uint32_t _freeLastTick;
     SequenceState _sequenceState;
     int _currentStep;
     bool _prevCondition;
@@ -81,6 +87,11 @@ private:
     bool _slideActive;
     unsigned int _currentStageRepeat;
 
+    // timing the current schedule is based on
+    uint32_t _scheduleDivisor = 0;
+    uint32_t _scheduleResetDivisor = 0;
+    Types::PlayMode _schedulePlayMode = Types::PlayMode::Last;
+
     struct Gate {
         uint32_t tick;
         bool gate;
@@ -0,0 +1,177 @@
+#include "OutputScheduler.h"
+
+#include "os/os.h"
+
+#include "drivers/HighResolutionTimer.h"
+
+#include <algorithm>
+
+static inline bool timeBefore(uint32_t a, uint32_t b) {
+    return int32_t(a - b) < 0;
+}
+
+OutputScheduler::OutputScheduler(OutputTimer &timer, GateOutput &gateOutput, Dac &dac) :
+    _timer(timer),
+    _gateOutput(gateOutput),
+    _dac(dac)
+{}
+
+void OutputScheduler::init(const CvOutput &cvOutput) {
+    _lastTime = HighResolutionTimer::us();
+
+    // bring outputs to a known state
+    _gates = 0;
+    _gateOutput.setGates(_gates);
+    _gateOutput.update();
+    for (int channel = 0; channel < CvOutput::Channels; ++channel) {
+        _cvValues[channel] = cvOutput.value(channel);
+        _cvNextValues[channel] = _cvValues[channel];
+        _dac.setValue(channel, _cvValues[channel]);
+    }
+    _dac.write();
+
+    _timer.setListener(this);
+}
+
+void OutputScheduler::schedule(uint32_t time, uint8_t gates, const CvOutput &cvOutput, uint32_t rampDuration) {
+    time += Latency;
+
+    // keep events ordered, ticks are processed in order but the fallback times may not be
+    if (timeBefore(time, _lastTime)) {
+        time = _lastTime;
+    }
+    _lastTime = time;
+
+    uint32_t now = HighResolutionTimer::us();
+    int pushed = 0;
+
+    // only queue changes, keep the previous state on failure to retry on the next call
+    if (gates != _gates && _queue.write({ time, EventType::Gates, 0, gates, 0, 0 })) {
+        _gates = gates;
+        ++pushed;
+    }
+    for (int channel = 0; channel < CvOutput::Channels; ++channel) {
+        Dac::Value value = cvOutput.value(channel);
+        Dac::Value nextValue = cvOutput.nextValue(channel);
+        if ((value != _cvValues[channel] || nextValue != _cvNextValues[channel]) &&
+            _queue.write({ time, EventType::Cv, uint8_t(channel), value, nextValue, uint16_t(rampDuration) })) {
+            _cvValues[channel] = value;
+            _cvNextValues[channel] = nextValue;
+            ++pushed;
+        }
+    }
+
+    if (pushed > 0) {
+        if (timeBefore(time, now)) {
+            _lateEvents += pushed;
+        }
+        os::InterruptLock lock;
+        // an armed timer always fires for an earlier event, otherwise the queue only holds the events pushed above
+        if (!_armed) {
+            _armed = true;
+            _timer.schedule(timeBefore(now, time) ? time - now : 0);
+        }
+    }
+}
+
+OutputScheduler::Stats OutputScheduler::stats() const {
+    return {
+        .events = _events,
+        .lateEvents = _lateEvents,
+        .droppedEvents = _queue.dropped(),
+        .maxLateness = _maxLateness,
+        .streamSamples = _streamSamples,
+        .dacWrites = _dac.writeCount() - _dacWriteCountBase
+    };
+}
+
+void OutputScheduler::resetStats() {
+    os::InterruptLock lock;
+    _events = 0;
+    _lateEvents = 0;
+    _maxLateness = 0;
+    _streamSamples = 0;
+    _dacWriteCountBase = _dac.writeCount();
+}
+
+void OutputScheduler::onOutputTimer() {
+    uint32_t now = HighResolutionTimer::us();
+
+    bool gatesChanged = false;
+    uint32_t cvChanged = 0;
+
+    Event event;
+    while (_queue.peek(event) && !timeBefore(now, event.time)) {
+        _queue.read(event);
+        switch (event.type) {
+        case EventType::Gates:
+            _gateOutput.setGates(event.value);
+            gatesChanged = true;
+            break;
+        case EventType::Cv:
+            _dac.setValue(event.channel, event.value);
+            cvChanged |= (1 << event.channel);
+            startRamp(event);
+            break;
+        }
+        ++_events;
+        _maxLateness = std::max(_maxLateness, now - event.time);
+    }
+
+    cvChanged |= updateRamps(now);
+
+    if (gatesChanged) {
+        _gateOutput.update();
+    }
+    if (cvChanged) {
+        _dac.writeChannels(cvChanged);
+    }
+
+    if (_queue.peek(event)) {
+        _timer.schedule(_rampChannels ? std::min(event.time - now, StreamInterval) : event.time - now);
+    } else if (_rampChannels) {
+        _timer.schedule(StreamInterval);
+    } else {
+        _armed = false;
+    }
+}
+
+void OutputScheduler::startRamp(const Event &event) {
+    uint32_t mask = 1 << event.channel;
+    if (event.nextValue != event.value && event.duration > 0) {
+        _ramps[event.channel] = { event.time, event.duration, event.value, event.nextValue, event.value };
+        _rampChannels |= mask;
+    } else {
+        _rampChannels &= ~mask;
+    }
+}
+
+uint32_t OutputScheduler::updateRamps(uint32_t now) {
+    uint32_t changed = 0;
+
+    for (int channel = 0; channel < CvOutput::Channels; ++channel) {
+        uint32_t mask = 1 << channel;
+        if (!(_rampChannels & mask)) {
+            continue;
+        }
+        auto &ramp = _ramps[channel];
+        uint32_t elapsed = now - ramp.time;
+        Dac::Value value;
+        if (elapsed >= ramp.duration) {
+            value = ramp.to;
+            _rampChannels &= ~mask;
+        } else {
+            // 16 bit fraction avoids 64 bit division
+            uint32_t fraction = (elapsed << 16) / ramp.duration;
+            value = ramp.from + int32_t((int64_t(int32_t(ramp.to) - int32_t(ramp.from)) * fraction) >> 16);
+        }
+        if (value != ramp.value) {
+            ramp.value = value;
+            _dac.setValue(channel, value);
+            changed |= mask;
+            ++_streamSamples;
+        }
+    }
+
+    return changed;
+}
@@ -0,0 +1,100 @@
+#pragma once
+
+#include "Config.h"
+
+#include "CvOutput.h"
+
+#include "core/utils/SpscQueue.h"
+
+#include "drivers/Dac.h"
+#include "drivers/GateOutput.h"
+#include "drivers/OutputTimer.h"
+
+#include <array>
+
+#include <cstdint>
+
+// Applies gate and cv output changes at their scheduled time.
+// The engine schedules the output state for each tick using the time the tick was generated at, delayed by
+// CONFIG_OUTPUT_LATENCY. Only changes are queued, the output timer interrupt applies them at their exact time.
+// This decouples output timing from the 1ms engine task period. The output timer interrupt is the only context
+// writing to the gate outputs and the dac.
+// Streamed cv channels (next value differs from the current one) ramp linearly towards the next value over the
+// given ramp duration. The timer interrupt renders the ramps at CONFIG_OUTPUT_STREAM_INTERVAL while they are active.
+class OutputScheduler : private OutputTimer::Listener {
+public:
+    static constexpr uint32_t Latency = CONFIG_OUTPUT_LATENCY;
+    static constexpr uint32_t StreamInterval = CONFIG_OUTPUT_STREAM_INTERVAL;
+
+    struct Stats {
+        uint32_t events;            // number of applied events
+        uint32_t lateEvents;        // number of events scheduled after their time (engine lagging behind latency)
+        uint32_t droppedEvents;     // number of events that did not fit the queue (retried on next schedule)
+        uint32_t maxLateness;       // maximum time an event was applied after its time (us)
+        uint32_t streamSamples;     // number of interpolated cv values written by streamed channels
+        uint32_t dacWrites;         // number of dac channel writes
+    };
+
+    OutputScheduler(OutputTimer &timer, GateOutput &gateOutput, Dac &dac);
+
+    // applies the initial output state right away
+    void init(const CvOutput &cvOutput);
+
+    // schedules the gate and cv output state at the given time (see HighResolutionTimer::us())
+    // streamed cv channels reach their next value after rampDuration (us)
+    void schedule(uint32_t time, uint8_t gates, const CvOutput &cvOutput, uint32_t rampDuration);
+
+    Stats stats() const;
+    void resetStats();
+
+private:
+    // OutputTimer::Listener
+    virtual void onOutputTimer() override;
+
+    enum class EventType : uint8_t {
+        Gates,
+        Cv,
+    };
+
+    struct Event {
+        uint32_t time;
+        EventType type;
+        uint8_t channel;
+        uint16_t value;
+        uint16_t nextValue;
+        uint16_t duration;
+    };
+
+    struct Ramp {
+        uint32_t time;
+        uint16_t duration;
+        Dac::Value from;
+        Dac::Value to;
+        Dac::Value value;
+    };
+
+    void startRamp(const Event &event);
+    uint32_t updateRamps(uint32_t now);
+
+    OutputTimer &_timer;
+    GateOutput &_gateOutput;
+    Dac &_dac;
+
+    SpscQueue<Event, 64> _queue;
+    volatile bool _armed = false;
+
+    // producer state
+    uint32_t _lastTime = 0;
+    uint8_t _gates = 0;
+    std::array<Dac::Value, CvOutput::Channels> _cvValues;
+    std::array<Dac::Value, CvOutput::Channels> _cvNextValues;
+    uint32_t _lateEvents = 0;
+
+    // consumer state
+    std::array<Ramp, CvOutput::Channels> _ramps;
+    uint32_t _rampChannels = 0;
+    uint32_t _events = 0;
+    uint32_t _maxLateness = 0;
+    uint32_t _streamSamples = 0;
+    uint32_t _dacWriteCountBase = 0;
+};
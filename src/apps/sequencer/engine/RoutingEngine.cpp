@@ -1,139 +1,174 @@
 #include "RoutingEngine.h"
 
 #include "Engine.h"
-#include "MidiUtils.h"
+
+#include "core/profiler/Profiler.h"
+
+#include <limits>
 
 // for allowing direct mapping
 static_assert(int(MidiPort::Midi) == int(Types::MidiPort::Midi), "invalid mapping");
 static_assert(int(MidiPort::UsbMidi) == int(Types::MidiPort::UsbMidi), "invalid mapping");
 
+PROFILER_INTERVAL(routingUpdate, "routing update")
+
+// values of targets that are only written by routing are rewritten at this interval (in updates) even if unchanged,
+// this restores routed values after model changes like switching the track mode or pasting a sequence
+static constexpr uint32_t RefreshInterval = 64;
+
 RoutingEngine::RoutingEngine(Engine &engine, Model &model) :
     _engine(engine),
     _routing(model.project().routing())
-{}
+{
+    _sourceValues.fill(0.f);
+}
 
 void RoutingEngine::update() {
-    updateSources();
+    PROFILER_INTERVAL_SCOPE(routingUpdate)
+
+    if (_routing.isDirty()) {
+        compileRoutes();
+    }
+
     updateSinks();
 }
 
+// key of a message in the midi route index, -1 if no route can match
+static int midiRouteKey(const MidiMessage &message) {
+    if (message.isControlChange()) {
+        return message.controlNumber();
+    } else if (message.isNoteOn() || message.isNoteOff()) {
+        return 128 + message.note();
+    } else if (message.isPitchBend()) {
+        return 256;
+    }
+    return -1;
+}
+
+// key of a route in the midi route index, -1 for note range routes
+static int midiRouteKey(const Routing::MidiSource &midiSource) {
+    switch (midiSource.event()) {
+    case Routing::MidiSource::Event::ControlAbsolute:
+    case Routing::MidiSource::Event::ControlRelative:
+        return midiSource.controlNumber();
+    case Routing::MidiSource::Event::PitchBend:
+        return 256;
+    case Routing::MidiSource::Event::NoteMomentary:
+    case Routing::MidiSource::Event::NoteToggle:
+    case Routing::MidiSource::Event::NoteVelocity:
+        return 128 + midiSource.note();
+    case Routing::MidiSource::Event::NoteRange:
+    case Routing::MidiSource::Event::Last:
+        break;
+    }
+    return -1;
+}
+
 bool RoutingEngine::receiveMidi(MidiPort port, const MidiMessage &message) {
+    if (_routing.isDirty()) {
+        compileRoutes();
+    }
+
+    int portIndex = int(port);
+    if (portIndex >= MidiRoutePortCount) {
+        return false;
+    }
+
+    int key = midiRouteKey(message);
+    if (key < 0) {
+        return false;
+    }
+
     bool consumed = false;
 
-    for (int routeIndex = 0; routeIndex < CONFIG_ROUTE_COUNT; ++routeIndex) {
-        const auto &route = _routing.route(routeIndex);
-        if (route.active() &&
-            route.source() == Routing::Source::Midi &&
-            MidiUtils::matchSource(port, message, route.midiSource().source())
-        ) {
-            const auto &midiSource = route.midiSource();
-            auto &sourceValue = _sourceValues[routeIndex];
-            switch (midiSource.event()) {
-            case Routing::MidiSource::Event::ControlAbsolute:
-                if (message.controlNumber() == midiSource.controlNumber()) {
-                    sourceValue = message.controlValue() * (1.f / 127.f);
-                    consumed = true;
-                }
-                break;
-            case Routing::MidiSource::Event::ControlRelative:
-                if (message.controlNumber() == midiSource.controlNumber()) {
-                    int value = message.controlValue();
-                    value = value >= 64 ? 64 - value : value;
-                    sourceValue = clamp(sourceValue + value * (1.f / 127.f), 0.f, 1.f);
-                    consumed = true;
-                }
-                break;
-            case Routing::MidiSource::Event::PitchBend:
-                if (message.isPitchBend()) {
-                    sourceValue = (message.pitchBend() + 0x2000) * (1.f / 16383.f);
-                    consumed = true;
-                }
-                break;
-            case Routing::MidiSource::Event::NoteMomentary:
-                if (message.isNoteOn() && message.note() == midiSource.note()) {
-                    sourceValue = 1.f;
-                    consumed = true;
-                } else if (message.isNoteOff() && message.note() == midiSource.note()) {
-                    sourceValue = 0.f;
-                    consumed = true;
-                }
-                break;
-            case Routing::MidiSource::Event::NoteToggle:
-                if (message.isNoteOn() && message.note() == midiSource.note()) {
-                    sourceValue = sourceValue < 0.5f ? 1.f : 0.f;
-                    consumed = true;
-                }
-                break;
-            case Routing::MidiSource::Event::NoteVelocity:
-                if (message.isNoteOn() && message.note() == midiSource.note()) {
-                    sourceValue = message.velocity() * (1.f / 127.f);
-                    consumed = true;
-                }
-                break;
-            case Routing::MidiSource::Event::NoteRange:
-                if (message.isNoteOn() && message.note() >= midiSource.note() && message.note() < midiSource.note() + midiSource.noteRange()) {
-                    sourceValue = (message.note() - midiSource.note()) / float(midiSource.noteRange() - 1);
-                    consumed = true;
-                }
-                break;
-            case Routing::MidiSource::Event::Last:
-                break;
-            }
+    for (int routeIndex = _midiRouteHeads[portIndex][key]; routeIndex != MidiRouteNone; routeIndex = _midiRouteNext[routeIndex]) {
+        consumed |= receiveRouteMidi(routeIndex, message);
+    }
+
+    if (key >= 128 && key < 256) {
+        for (int routeIndex = _midiNoteRangeRouteHeads[portIndex]; routeIndex != MidiRouteNone; routeIndex = _midiRouteNext[routeIndex]) {
+            consumed |= receiveRouteMidi(routeIndex, message);
         }
     }
 
     return consumed;
 }
 
-void RoutingEngine::updateSources() {
-    for (int routeIndex = 0; routeIndex < CONFIG_ROUTE_COUNT; ++routeIndex) {
-        const auto &route = _routing.route(routeIndex);
-        if (route.active()) {
-            auto &sourceValue = _sourceValues[routeIndex];
-            switch (route.source()) {
-            case Routing::Source::None:
-                sourceValue = 0.f;
-                break;
-            case Routing::Source::CvIn1:
-            case Routing::Source::CvIn2:
-            case Routing::Source::CvIn3:
-            case Routing::Source::CvIn4: {
-                const auto &range = Types::voltageRangeInfo(route.cvSource().range());
-                int index = int(route.source()) - int(Routing::Source::CvIn1);
-                sourceValue = range.normalize(_engine.cvInput().channel(index));
-                break;
-            }
-            case Routing::Source::CvOut1:
-            case Routing::Source::CvOut2:
-            case Routing::Source::CvOut3:
-            case Routing::Source::CvOut4:
-            case Routing::Source::CvOut5:
-            case Routing::Source::CvOut6:
-            case Routing::Source::CvOut7:
-            case Routing::Source::CvOut8: {
-                const auto &range = Types::voltageRangeInfo(route.cvSource().range());
-                int index = int(route.source()) - int(Routing::Source::CvOut1);
-                sourceValue = range.normalize(_engine.cvOutput().channel(index));
-                break;
-            }
-            case Routing::Source::Midi:
-                // handled in receiveMidi
-                break;
-            case Routing::Source::Last:
-                break;
-            }
+bool RoutingEngine::receiveRouteMidi(int routeIndex, const MidiMessage &message) {
+    const auto &midiSource = _routing.route(routeIndex).midiSource();
+    const auto &source = midiSource.source();
+    if (!source.isOmni() && message.channel() != source.channel()) {
+        return false;
+    }
+
+    bool consumed = false;
+    auto &sourceValue = _sourceValues[routeIndex];
+
+    switch (midiSource.event()) {
+    case Routing::MidiSource::Event::ControlAbsolute:
+        if (message.controlNumber() == midiSource.controlNumber()) {
+            sourceValue = message.controlValue() * (1.f / 127.f);
+            consumed = true;
+        }
+        break;
+    case Routing::MidiSource::Event::ControlRelative:
+        if (message.controlNumber() == midiSource.controlNumber()) {
+            int value = message.controlValue();
+            value = value >= 64 ? 64 - value : value;
+            sourceValue = clamp(sourceValue + value * (1.f / 127.f), 0.f, 1.f);
+            consumed = true;
+        }
+        break;
+    case Routing::MidiSource::Event::PitchBend:
+        if (message.isPitchBend()) {
+            sourceValue = (message.pitchBend() + 0x2000) * (1.f / 16383.f);
+            consumed = true;
         }
+        break;
+    case Routing::MidiSource::Event::NoteMomentary:
+        if (message.isNoteOn() && message.note() == midiSource.note()) {
+            sourceValue = 1.f;
+            consumed = true;
+        } else if (message.isNoteOff() && message.note() == midiSource.note()) {
+            sourceValue = 0.f;
+            consumed = true;
+        }
+        break;
+    case Routing::MidiSource::Event::NoteToggle:
+        if (message.isNoteOn() && message.note() == midiSource.note()) {
+            sourceValue = sourceValue < 0.5f ? 1.f : 0.f;
+            consumed = true;
+        }
+        break;
+    case Routing::MidiSource::Event::NoteVelocity:
+        if (message.isNoteOn() && message.note() == midiSource.note()) {
+            sourceValue = message.velocity() * (1.f / 127.f);
+            consumed = true;
+        }
+        break;
+    case Routing::MidiSource::Event::NoteRange:
+        if (message.isNoteOn() && message.note() >= midiSource.note() && message.note() < midiSource.note() + midiSource.noteRange()) {
+            sourceValue = (message.note() - midiSource.note()) / float(midiSource.noteRange() - 1);
+            consumed = true;
+        }
+        break;
+    case Routing::MidiSource::Event::Last:
+        break;
     }
+
+    return consumed;
 }
 
-void RoutingEngine::updateSinks() {
+void RoutingEngine::compileRoutes() {
+    _activeRouteCount = 0;
+    _midiRouteCount = 0;
+
     for (int routeIndex = 0; routeIndex < CONFIG_ROUTE_COUNT; ++routeIndex) {
         const auto &route = _routing.route(routeIndex);
         auto &routeState = _routeStates[routeIndex];
 
-        bool routeChanged = route.target() != routeState.target || route.tracks() != routeState.tracks;
-
-        if (routeChanged) {
+        // update set of routed targets
+        if (route.target() != routeState.target || route.tracks() != routeState.tracks) {
             // disable previous routing
             Routing::setRouted(routeState.target, routeState.tracks, false);
             // reset last state for play/record toggle
@@ -143,28 +178,98 @@ void RoutingEngine::updateSinks() {
             if (routeState.target == Routing::Target::RecordToggle) {
                 _lastRecordToggleActive = false;
             }
-        }
-
-        if (route.active()) {
-            auto target = route.target();
-            float value = route.min() + _sourceValues[routeIndex] * (route.max() - route.min());
-            if (Routing::isEngineTarget(target)) {
-                writeEngineTarget(target, value);
-            } else {
-                _routing.writeTarget(target, route.tracks(), value);
-            }
-        }
-
-        if (routeChanged) {
             // enable new routing
             Routing::setRouted(route.target(), route.tracks(), true);
             // save state
             routeState.target = route.target();
             routeState.tracks = route.tracks();
         }
+
+        if (!route.active()) {
+            continue;
+        }
+
+        auto &activeRoute = _activeRoutes[_activeRouteCount++];
+        activeRoute.routeIndex = routeIndex;
+        activeRoute.target = route.target();
+        activeRoute.tracks = route.tracks();
+        activeRoute.cvSource = nullptr;
+        activeRoute.cvRange = &Types::voltageRangeInfo(route.cvSource().range());
+        activeRoute.min = route.min();
+        activeRoute.range = route.max() - route.min();
+        activeRoute.lastValue = std::numeric_limits<float>::quiet_NaN();
+
+        auto source = route.source();
+        if (source >= Routing::Source::CvIn1 && source <= Routing::Source::CvIn4) {
+            activeRoute.cvSource = &_engine.cvInput().channel(int(source) - int(Routing::Source::CvIn1));
+        } else if (source >= Routing::Source::CvOut1 && source <= Routing::Source::CvOut8) {
+            activeRoute.cvSource = &_engine.cvOutput().channel(int(source) - int(Routing::Source::CvOut1));
+        } else if (source == Routing::Source::Midi) {
+            // source value is set in receiveMidi
+            _midiRoutes[_midiRouteCount++] = routeIndex;
+        } else {
+            _sourceValues[routeIndex] = 0.f;
+        }
+
+        // engine and play state targets are applied continuously, they also change by other means
+        if (Routing::isEngineTarget(activeRoute.target)) {
+            activeRoute.write = &RoutingEngine::writeEngineRoute;
+            activeRoute.writeChanges = false;
+        } else {
+            activeRoute.write = &RoutingEngine::writeModelRoute;
+            activeRoute.writeChanges = !Routing::isPlayStateTarget(activeRoute.target);
+        }
+    }
+
+    indexMidiRoutes();
+
+    _routing.clearDirty();
+}
+
+void RoutingEngine::indexMidiRoutes() {
+    for (auto &heads : _midiRouteHeads) {
+        heads.fill(MidiRouteNone);
+    }
+    _midiNoteRangeRouteHeads.fill(MidiRouteNone);
+
+    // insert in reverse order to dispatch in route order
+    for (int i = _midiRouteCount - 1; i >= 0; --i) {
+        int routeIndex = _midiRoutes[i];
+        const auto &midiSource = _routing.route(routeIndex).midiSource();
+        int portIndex = int(midiSource.source().port());
+        if (portIndex >= MidiRoutePortCount) {
+            continue;
+        }
+        int key = midiRouteKey(midiSource);
+        auto &head = key >= 0 ? _midiRouteHeads[portIndex][key] : _midiNoteRangeRouteHeads[portIndex];
+        _midiRouteNext[routeIndex] = head;
+        head = routeIndex;
     }
 }
 
+void RoutingEngine::updateSinks() {
+    bool refresh = ++_updateCount % RefreshInterval == 0;
+
+    for (int i = 0; i < _activeRouteCount; ++i) {
+        auto &activeRoute = _activeRoutes[i];
+        float sourceValue = activeRoute.cvSource ? activeRoute.cvRange->normalize(*activeRoute.cvSource) : _sourceValues[activeRoute.routeIndex];
+        float value = activeRoute.min + sourceValue * activeRoute.range;
+        if (activeRoute.writeChanges && value == activeRoute.lastValue && !refresh) {
+            continue;
+        }
+        activeRoute.lastValue = value;
+        (this->*activeRoute.write)(activeRoute, value);
+    }
+}
+
+void RoutingEngine::writeEngineRoute(const ActiveRoute &activeRoute, float value) {
+    writeEngineTarget(activeRoute.target, value);
+}
+
+void RoutingEngine::writeModelRoute(const ActiveRoute &activeRoute, float value) {
+    _routing.writeTarget(activeRoute.target, activeRoute.tracks, value);
+}
+
 void RoutingEngine::writeEngineTarget(Routing::Target target, float normalized) {
     bool active = normalized > 0.5f;
 
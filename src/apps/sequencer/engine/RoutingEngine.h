@@ -23,9 +23,32 @@ public:
     bool receiveMidi(MidiPort port, const MidiMessage &message);
 
 private:
-    void updateSources();
+    void compileRoutes();
+    void indexMidiRoutes();
     void updateSinks();
 
+    bool receiveRouteMidi(int routeIndex, const MidiMessage &message);
+
+    // active route with pre-resolved source and target
+    struct ActiveRoute;
+    typedef void (RoutingEngine::*WriteFunction)(const ActiveRoute &activeRoute, float value);
+
+    struct ActiveRoute {
+        uint8_t routeIndex;
+        Routing::Target target;
+        Types::TrackBits tracks;
+        const float *cvSource;                      // cv channel or nullptr if source value is set by midi
+        const Types::VoltageRangeInfo *cvRange;
+        float min;
+        float range;
+        WriteFunction write;
+        bool writeChanges;                          // only write changed values (targets only written by routing)
+        float lastValue;
+    };
+
+    void writeEngineRoute(const ActiveRoute &activeRoute, float value);
+    void writeModelRoute(const ActiveRoute &activeRoute, float value);
+
     void writeEngineTarget(Routing::Target target, float normalized);
 
     Engine &_engine;
@@ -35,11 +58,28 @@ private:
 
     struct RouteState {
         Routing::Target target = Routing::Target::None;
-        uint8_t tracks = 0;
+        Types::TrackBits tracks = 0;
     };
 
     std::array<RouteState, CONFIG_ROUTE_COUNT> _routeStates;
 
+    std::array<ActiveRoute, CONFIG_ROUTE_COUNT> _activeRoutes;
+    int _activeRouteCount = 0;
+    std::array<uint8_t, CONFIG_ROUTE_COUNT> _midiRoutes;
+    int _midiRouteCount = 0;
+
+    // index of midi routes by port and message key (control number, note or pitch bend),
+    // each entry is the first route of a chain linked through _midiRouteNext
+    static constexpr int MidiRoutePortCount = int(Types::MidiPort::Last);
+    static constexpr int MidiRouteKeyCount = 128 + 128 + 1;
+    static constexpr uint8_t MidiRouteNone = 0xff;
+    static_assert(CONFIG_ROUTE_COUNT < MidiRouteNone, "route index does not fit");
+
+    std::array<std::array<uint8_t, MidiRouteKeyCount>, MidiRoutePortCount> _midiRouteHeads;
+    std::array<uint8_t, MidiRoutePortCount> _midiNoteRangeRouteHeads;   // note range routes, matched by all notes
+    std::array<uint8_t, CONFIG_ROUTE_COUNT> _midiRouteNext;
+    uint32_t _updateCount = 0;
+
     uint8_t _lastPlayToggleActive = false;
     uint8_t _lastRecordToggleActive = false;
 };
@@ -9,6 +9,7 @@
 
 #include "core/midi/MidiMessage.h"
 #include "core/utils/EnumUtils.h"
+#include "core/utils/Random.h"
 
 #include <cstdint>
 
@@ -43,12 +44,25 @@ public:
         _trackState(model.project().playState().trackState(track.trackIndex())),
         _linkedTrackEngine(linkedTrackEngine)
     {
+        resetRandom();
         changePattern();
     }
 
     const TrackEngine *linkedTrackEngine() const { return _linkedTrackEngine; }
     void setLinkedTrackEngine(const TrackEngine *linkedTrackEngine) {
-        _linkedTrackEngine = linkedTrackEngine;
+        if (linkedTrackEngine != _linkedTrackEngine) {
+            _linkedTrackEngine = linkedTrackEngine;
+            invalidateSchedule();
+        }
+    }
+
+    // track engines other tracks are linked to need to be ticked on every tick to keep their link data current
+    bool isLinkSource() const { return _linkSource; }
+    void setLinkSource(bool linkSource) {
+        if (linkSource != _linkSource) {
+            _linkSource = linkSource;
+            invalidateSchedule();
+        }
     }
 
     template<typename T>
@@ -74,6 +88,18 @@ public:
 
     virtual void changePattern() {}
 
+    // restarts the random sequence from the project seed, called on engine reset
+    void resetRandom() {
+        _rng = Random(Random::hash(_model.project().randomSeed() * CONFIG_TRACK_COUNT + _track.trackIndex()));
+    }
+
+    // scheduling
+
+    // next tick at which tick() has work to do, the engine skips calling tick() on all ticks before
+    // track engines that don't schedule their work leave this at 0 and are ticked on every tick
+    uint32_t nextTick() const { return _nextTick; }
+    void invalidateSchedule() { _nextTick = 0; }
+
     virtual bool receiveMidi(MidiPort port, const MidiMessage &message) { return false; }
     virtual void monitorMidi(uint32_t tick, const MidiMessage &message) {}
     virtual void clearMidiMonitoring() {}
@@ -85,6 +111,8 @@ public:
     virtual bool activity() const = 0;
     virtual bool gateOutput(int index) const = 0;
     virtual float cvOutput(int index) const = 0;
+    // cv output at the next tick, streamed outputs ramp towards it in between ticks
+    virtual float cvOutputNext(int index) const { return cvOutput(index); }
 
     virtual float sequenceProgress() const { return -1.f; }
 
@@ -100,11 +128,21 @@ public:
     int fillAmount() const { return _trackState.fillAmount(); }
 
 protected:
+    // restarts the random sequence from a pattern's locked seed, unlocked patterns (seed 0) continue the sequence
+    void lockRandom(int seed) {
+        if (seed != 0) {
+            _rng = Random(Random::hash(seed));
+        }
+    }
+
     Engine &_engine;
     const Model &_model;
     Track &_track;
     const PlayState::TrackState &_trackState;
     const TrackEngine *_linkedTrackEngine;
+    bool _linkSource = false;
+    uint32_t _nextTick = 0;
+    Random _rng;
 };
 
 ENUM_CLASS_OPERATORS(TrackEngine::TickResult)
@@ -1,9 +1,12 @@
 #include "Calibration.h"
 
+uint32_t Calibration::CvOutput::_nextRevision = 0;
+
 void Calibration::CvOutput::clear() {
     for (size_t i = 0; i < _items.size(); ++i) {
         _items[i] = defaultItemValue(i);
     }
+    touch();
 }
 
 void Calibration::CvOutput::write(VersionedSerializedWriter &writer) const {
@@ -16,6 +19,7 @@ void Calibration::CvOutput::read(VersionedSerializedReader &reader) {
     for (size_t i = 0; i < _items.size(); ++i) {
         reader.read(_items[i]);
     }
+    touch();
 }
 
 void Calibration::CvOutput::update() {
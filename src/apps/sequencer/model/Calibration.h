@@ -43,6 +43,7 @@ public:
 
         void setItem(int index, int value, bool doUpdate = true) {
             _items[index] = (_items[index] & 0x8000) | clamp(value, 0, 0x7fff);
+            touch();
             if (doUpdate) {
                 update();
             }
@@ -68,6 +69,7 @@ public:
 
         void setUserDefined(int index, bool value) {
             _items[index] = (_items[index] & 0x7fff) | (value ? 0x8000 : 0);
+            touch();
             update();
         }
 
@@ -95,6 +97,9 @@ public:
             }
         }
 
+        // changes whenever the items change, used to cache derived data
+        uint32_t revision() const { return _revision; }
+
         void clear();
 
         void write(VersionedSerializedWriter &writer) const;
@@ -103,7 +108,13 @@ public:
     private:
         void update();
 
+        // revisions are unique across all calibrations, so copying a calibration also changes the revision
+        void touch() { _revision = ++_nextRevision; }
+
         ItemArray _items;
+        uint32_t _revision = 0;
+
+        static uint32_t _nextRevision;
     };
 
     typedef std::array<CvOutput, CONFIG_CV_OUTPUT_CHANNELS> CvOutputArray;
@@ -4,6 +4,8 @@
 void ClockSetup::clear() {
     _mode = Mode::Auto;
     _shiftMode = ShiftMode::Restart;
+    _slaveSync = SlaveSync::Pll;
+    _slaveResponse = 250;
     _clockInputDivisor = 12;
     _clockInputMode = ClockInputMode::Reset;
     _clockOutputDivisor = 12;
@@ -30,6 +32,8 @@ void ClockSetup::write(VersionedSerializedWriter &writer) const {
     writer.write(_midiTx);
     writer.write(_usbRx);
     writer.write(_usbTx);
+    writer.write(_slaveSync);
+    writer.write(_slaveResponse);
 }
 
 void ClockSetup::read(VersionedSerializedReader &reader) {
@@ -45,4 +49,6 @@ void ClockSetup::read(VersionedSerializedReader &reader) {
     reader.read(_midiTx);
     reader.read(_usbRx);
     reader.read(_usbTx);
+    reader.read(_slaveSync, ProjectVersion::Version35);
+    reader.read(_slaveResponse, ProjectVersion::Version35);
 }
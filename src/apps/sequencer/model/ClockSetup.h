@@ -46,6 +46,21 @@ public:
         return nullptr;
     }
 
+    enum class SlaveSync : uint8_t {
+        Pulse = 0,
+        Pll,
+        Last
+    };
+
+    static const char *slaveSyncName(SlaveSync sync) {
+        switch (sync) {
+        case SlaveSync::Pulse:  return "Pulse";
+        case SlaveSync::Pll:    return "PLL";
+        case SlaveSync::Last:   break;
+        }
+        return nullptr;
+    }
+
     enum class ClockInputMode : uint8_t {
         Reset = 0,
         Run,
@@ -116,6 +131,44 @@ public:
         str(shiftModeName(shiftMode()));
     }
 
+    // slaveSync
+
+    SlaveSync slaveSync() const { return _slaveSync; }
+    void setSlaveSync(SlaveSync slaveSync) {
+        slaveSync = ModelUtils::clampedEnum(slaveSync);
+        if (slaveSync != _slaveSync) {
+            _slaveSync = slaveSync;
+            _dirty = true;
+        }
+    }
+
+    void editSlaveSync(int value, int shift) {
+        setSlaveSync(ModelUtils::adjustedEnum(slaveSync(), value));
+    }
+
+    void printSlaveSync(StringBuilder &str) const {
+        str(slaveSyncName(slaveSync()));
+    }
+
+    // slaveResponse (ms)
+
+    int slaveResponse() const { return _slaveResponse; }
+    void setSlaveResponse(int slaveResponse) {
+        slaveResponse = clamp(slaveResponse, 10, 2000);
+        if (slaveResponse != _slaveResponse) {
+            _slaveResponse = slaveResponse;
+            _dirty = true;
+        }
+    }
+
+    void editSlaveResponse(int value, int shift) {
+        setSlaveResponse(slaveResponse() + value * (shift ? 100 : 10));
+    }
+
+    void printSlaveResponse(StringBuilder &str) const {
+        str("%dms", slaveResponse());
+    }
+
     // clockInputDivisor
 
     int clockInputDivisor() const { return _clockInputDivisor; }
@@ -316,6 +369,8 @@ public:
 private:
     Mode _mode;
     ShiftMode _shiftMode;
+    SlaveSync _slaveSync;
+    uint16_t _slaveResponse;
     uint8_t _clockInputDivisor;
     ClockInputMode _clockInputMode;
     uint8_t _clockOutputDivisor;
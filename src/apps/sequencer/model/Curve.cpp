@@ -206,4 +206,184 @@ Curve::Function Curve::function(Type type) {
 
 float Curve::eval(Type type, float x) {
     return functions[type](x);
-}
\ No newline at end of file
+}
+
+// Fixed point evaluation
+//
+// Every curve type is a basic shape, repeated one or more times per step, optionally limited to the first half of
+// the step, mirrored in time or inverted in value. The basic shapes are continuous, so they are stored as
+// interpolated tables generated at compile time and discontinuities are resolved exactly on the position.
+
+enum CurvePrimitive : uint8_t {
+    Flat,
+    Ramp,
+    Exp,
+    Log,
+    Smooth,
+    Triangle,
+    Bell,
+    PrimitiveCount,
+};
+
+enum CurveShapeFlags : uint8_t {
+    FirstHalf   = 1 << 0,
+    Mirror      = 1 << 1,
+    Invert      = 1 << 2,
+};
+
+struct CurveShape {
+    uint8_t primitive;
+    uint8_t repeats;
+    uint8_t flags;
+};
+
+static constexpr int TableSize = 257;
+
+struct CurveTable {
+    uint16_t values[TableSize];
+};
+
+static constexpr double sqrtNewton(double x, double guess, int iterations) {
+    return iterations == 0 ? guess : sqrtNewton(x, 0.5 * (guess + x / guess), iterations - 1);
+}
+
+static constexpr double constexprSqrt(double x) {
+    return x <= 0.0 ? 0.0 : sqrtNewton(x, 1.0, 24);
+}
+
+static constexpr double cosSeries(double a2, double term, double sum, int n) {
+    return n > 30 ? sum : cosSeries(a2, -term * a2 / ((n + 1) * (n + 2)), sum + term, n + 2);
+}
+
+// cosine for angles in [0, 2 pi]
+static constexpr double constexprCos(double a) {
+    return a > 3.14159265358979323846 ? constexprCos(2.0 * 3.14159265358979323846 - a) : cosSeries(a * a, 1.0, 0.0, 0);
+}
+
+static constexpr double primitiveValue(CurvePrimitive primitive, double x) {
+    return
+        primitive == Flat ? 1.0 :
+        primitive == Ramp ? x :
+        primitive == Exp ? x * x :
+        primitive == Log ? constexprSqrt(x) :
+        primitive == Smooth ? x * x * (3.0 - 2.0 * x) :
+        primitive == Triangle ? (x < 0.5 ? x : 1.0 - x) * 2.0 :
+        primitive == Bell ? 0.5 - 0.5 * constexprCos(x * 2.0 * 3.14159265358979323846) :
+        0.0;
+}
+
+static constexpr uint16_t tableValue(CurvePrimitive primitive, int index) {
+    return uint16_t(primitiveValue(primitive, double(index) / (TableSize - 1)) * Curve::FixedOne + 0.5);
+}
+
+template<int... Is>
+struct IndexSequence {};
+
+template<int N, int... Is>
+struct MakeIndexSequence : MakeIndexSequence<N - 1, N - 1, Is...> {};
+
+template<int... Is>
+struct MakeIndexSequence<0, Is...> : IndexSequence<Is...> {};
+
+template<int... Is>
+static constexpr CurveTable makeTable(CurvePrimitive primitive, IndexSequence<Is...>) {
+    return {{ tableValue(primitive, Is)... }};
+}
+
+static constexpr CurveTable tables[] = {
+    makeTable(Flat, MakeIndexSequence<TableSize>()),
+    makeTable(Ramp, MakeIndexSequence<TableSize>()),
+    makeTable(Exp, MakeIndexSequence<TableSize>()),
+    makeTable(Log, MakeIndexSequence<TableSize>()),
+    makeTable(Smooth, MakeIndexSequence<TableSize>()),
+    makeTable(Triangle, MakeIndexSequence<TableSize>()),
+    makeTable(Bell, MakeIndexSequence<TableSize>()),
+};
+
+static_assert(sizeof(tables) / sizeof(tables[0]) == PrimitiveCount, "invalid table count");
+static_assert(tables[Bell].values[TableSize / 2] == Curve::FixedOne, "invalid bell table");
+static_assert(tables[Log].values[TableSize / 4] == Curve::FixedOne / 2, "invalid log table");
+
+// same order as functions
+static constexpr CurveShape shapes[] = {
+    { Flat,     1, Invert },                // low
+    { Flat,     1, 0 },                     // high
+    { Flat,     1, FirstHalf | Invert },    // stepUp
+    { Flat,     1, FirstHalf },             // stepDown
+    { Ramp,     1, 0 },                     // rampUp
+    { Ramp,     1, Mirror },                // rampDown
+    { Ramp,     2, FirstHalf },             // rampUpHalf
+    { Ramp,     2, FirstHalf | Mirror },    // rampDownHalf
+    { Ramp,     2, 0 },                     // doubleRampUpHalf
+    { Ramp,     2, Mirror },                // doubleRampDownHalf
+    { Exp,      1, 0 },                     // expUp
+    { Exp,      1, Mirror },                // expDown
+    { Exp,      2, FirstHalf },             // expUpHalf
+    { Exp,      2, FirstHalf | Mirror },    // expDownHalf
+    { Exp,      2, 0 },                     // doubleExpUpHalf
+    { Exp,      2, Mirror },                // doubleExpDownHalf
+    { Log,      1, 0 },                     // logUp
+    { Log,      1, Mirror },                // logDown
+    { Log,      2, FirstHalf },             // logUpHalf
+    { Log,      2, FirstHalf | Mirror },    // logDownHalf
+    { Log,      2, 0 },                     // doubleLogUpHalf
+    { Log,      2, Mirror },                // doubleLogDownHalf
+    { Smooth,   1, 0 },                     // smoothUp
+    { Smooth,   1, Mirror },                // smoothDown
+    { Smooth,   2, FirstHalf },             // smoothUpHalf
+    { Smooth,   2, FirstHalf | Mirror },    // smoothDownHalf
+    { Smooth,   2, 0 },                     // doubleSmoothUpHalf
+    { Smooth,   2, Mirror },                // doubleSmoothDownHalf
+    { Triangle, 1, 0 },                     // triangle
+    { Triangle, 1, Invert },                // revTriangle
+    { Bell,     1, 0 },                     // bell
+    { Bell,     1, Invert },                // revBell
+    { Exp,      2, Mirror },                // expDown2x
+    { Exp,      2, 0 },                     // expUp2x
+    { Exp,      3, Mirror },                // expDown3x
+    { Exp,      3, 0 },                     // expUp3x
+    { Exp,      4, Mirror },                // expDown4x
+    { Exp,      4, 0 },                     // expUp4x
+};
+
+static_assert(sizeof(shapes) / sizeof(shapes[0]) == Curve::Last, "invalid shape count");
+static_assert(sizeof(functions) / sizeof(functions[0]) == Curve::Last, "invalid function count");
+
+// interpolated table lookup, x is in [0, 65536]
+static int lookup(const CurveTable &table, uint32_t x) {
+    uint32_t index = x >> 8;
+    if (index >= TableSize - 1) {
+        return table.values[TableSize - 1];
+    }
+    uint32_t fraction = x & 0xff;
+    return (table.values[index] * (256 - fraction) + table.values[index + 1] * fraction) >> 8;
+}
+
+static int lookup(CurvePrimitive primitive, uint32_t x) {
+    // the log curve is too steep to interpolate close to zero, use sqrt(x) = sqrt(16 x) / 4 instead
+    if (primitive == Log) {
+        int shift = 0;
+        while (x > 0 && x < 4096) {
+            x <<= 4;
+            shift += 2;
+        }
+        return lookup(tables[Log], x) >> shift;
+    }
+    return lookup(tables[primitive], x);
+}
+
+int Curve::evalFixed(Type type, uint32_t position, uint32_t length) {
+    const auto &shape = shapes[type];
+
+    int value = 0;
+    if (!(shape.flags & FirstHalf) || 2 * position < length) {
+        uint32_t segmentPosition = (position * shape.repeats) % length;
+        if (shape.flags & Mirror) {
+            segmentPosition = length - segmentPosition;
+        }
+        uint32_t x = length <= 0xffff ? (segmentPosition << 16) / length : uint32_t((uint64_t(segmentPosition) << 16) / length);
+        value = lookup(CurvePrimitive(shape.primitive), x);
+    }
+
+    return shape.flags & Invert ? FixedOne - value : value;
+}
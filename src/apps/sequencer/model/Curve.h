@@ -1,6 +1,9 @@
 #pragma once
 
 #include <map>
+
+#include <cstdint>
+
 class Curve {
 public:
     typedef float (*Function)(float x);
@@ -53,6 +56,13 @@ public:
 
     static float eval(Type type, float x);
 
+    // fixed point curve values, FixedOne equals 1.0
+    static constexpr int FixedOne = 1 << 15;
+
+    // evaluates the curve at position / length from precomputed tables, used by the engine
+    // the position is resolved exactly, so repeated shapes switch segments on the same tick as eval()
+    static int evalFixed(Type type, uint32_t position, uint32_t length);
+
  
 
 
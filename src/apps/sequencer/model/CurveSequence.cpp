@@ -163,6 +163,7 @@ void CurveSequence::clear() {
     setRange(Types::VoltageRange::Bipolar5V);
     setDivisor(12);
     setResetMeasure(0);
+    setSeed(0);
     setRunMode(Types::RunMode::Forward);
     setFirstStep(0);
     setLastStep(15);
@@ -215,6 +216,7 @@ void CurveSequence::write(VersionedSerializedWriter &writer) const {
     writer.write(_runMode.base);
     writer.write(_firstStep.base);
     writer.write(_lastStep.base);
+    writer.write(_seed);
 
     writeArray(writer, _steps);
 }
@@ -230,6 +232,7 @@ void CurveSequence::read(VersionedSerializedReader &reader) {
     reader.read(_runMode.base);
     reader.read(_firstStep.base);
     reader.read(_lastStep.base);
+    reader.read(_seed, ProjectVersion::Version36);
 
     readArray(reader, _steps);
 }
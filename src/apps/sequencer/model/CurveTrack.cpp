@@ -27,6 +27,7 @@ void CurveTrack::clear() {
     setPlayMode(Types::PlayMode::Aligned);
     setFillMode(FillMode::None);
     setMuteMode(MuteMode::LastValue);
+    setOutputMode(OutputMode::Tick);
     setSlideTime(0);
     setOffset(0);
     setRotate(0);
@@ -48,6 +49,7 @@ void CurveTrack::write(VersionedSerializedWriter &writer) const {
     writer.write(_rotate.base);
     writer.write(_shapeProbabilityBias.base);
     writer.write(_gateProbabilityBias.base);
+    writer.write(_outputMode);
     writeArray(writer, _sequences);
 }
 
@@ -61,5 +63,6 @@ void CurveTrack::read(VersionedSerializedReader &reader) {
     reader.read(_rotate.base);
     reader.read(_shapeProbabilityBias.base, ProjectVersion::Version15);
     reader.read(_gateProbabilityBias.base, ProjectVersion::Version15);
+    reader.read(_outputMode, ProjectVersion::Version37);
     readArray(reader, _sequences);
 }
@@ -58,6 +58,21 @@ public:
         return nullptr;
     }
 
+    enum class OutputMode : uint8_t {
+        Tick,
+        Stream,
+        Last
+    };
+
+    static const char *outputModeName(OutputMode outputMode) {
+        switch (outputMode) {
+        case OutputMode::Tick:      return "Tick";
+        case OutputMode::Stream:    return "Stream";
+        case OutputMode::Last:      break;
+        }
+        return nullptr;
+    }
+
     //----------------------------------------
     // Properties
     //----------------------------------------
@@ -114,6 +129,21 @@ public:
         str(muteModeName(muteMode()));
     }
 
+    // outputMode
+
+    OutputMode outputMode() const { return _outputMode; }
+    void setOutputMode(OutputMode outputMode) {
+        _outputMode = ModelUtils::clampedEnum(outputMode);
+    }
+
+    void editOutputMode(int value, bool shift) {
+        setOutputMode(ModelUtils::adjustedEnum(outputMode(), value));
+    }
+
+    void printOutputMode(StringBuilder &str) const {
+        str(outputModeName(outputMode()));
+    }
+
     // slideTime
 
     int slideTime() const { return _slideTime.get(isRouted(Routing::Target::SlideTime)); }
@@ -245,6 +275,7 @@ private:
     Types::PlayMode _playMode;
     FillMode _fillMode;
     MuteMode _muteMode;
+    OutputMode _outputMode;
     Routable<uint8_t> _slideTime;
     Routable<int16_t> _offset;
     Routable<int8_t> _rotate;
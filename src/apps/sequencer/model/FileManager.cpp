@@ -5,6 +5,7 @@
 #include "core/fs/FileSystem.h"
 #include "core/fs/FileWriter.h"
 #include "core/fs/FileReader.h"
+#include "core/fs/Directory.h"
 
 #include "os/os.h"
 
@@ -15,8 +16,16 @@
 uint32_t FileManager::_volumeState = 0;
 uint32_t FileManager::_nextVolumeStateCheckTicks = 0;
 
-std::array<FileManager::CachedSlotInfo, 4> FileManager::_cachedSlotInfos;
-uint32_t FileManager::_cachedSlotInfoTicket = 0;
+std::array<FileManager::SlotIndex, 2> FileManager::_slotIndex;
+
+FileManager::ProjectBlocks FileManager::_projectBlocks;
+
+volatile FileManager::ProjectCueState FileManager::_projectCueState = FileManager::ProjectCueState::Empty;
+int FileManager::_projectCueSlot = -1;
+#ifdef CONFIG_ENABLE_PROJECT_CUE
+UserScale::Array FileManager::_projectCueUserScales;
+Project FileManager::_projectCue(FileManager::_projectCueUserScales);
+#endif
 
 FileManager::TaskExecuteCallback FileManager::_taskExecuteCallback;
 FileManager::TaskResultCallback FileManager::_taskResultCallback;
@@ -37,6 +46,30 @@ static void slotPath(StringBuilder &str, FileType type, int slot) {
     str("%s/%03d.%s", info.dir, slot + 1, info.ext);
 }
 
+// returns the slot of a slot file name or -1 for other files
+static int slotFromFilename(FileType type, const char *name) {
+    const auto &info = fileTypeInfos[int(type)];
+    int number = 0;
+    for (int i = 0; i < 3; ++i) {
+        if (name[i] < '0' || name[i] > '9') {
+            return -1;
+        }
+        number = number * 10 + name[i] - '0';
+    }
+    if (name[3] != '.' || std::strcmp(&name[4], info.ext) != 0) {
+        return -1;
+    }
+    return (number >= 1 && number <= FileManager::SlotCount) ? number - 1 : -1;
+}
+
+static void slotIndexPath(StringBuilder &str, FileType type) {
+    const auto &info = fileTypeInfos[int(type)];
+    str("%s/SLOTS.IDX", info.dir);
+}
+
+static constexpr uint32_t SlotIndexMagic = 0x58444953; // SIDX
+static constexpr uint32_t SlotIndexVersion = 2;
+
 void FileManager::init() {
     _volumeState = 0;
     _nextVolumeStateCheckTicks = 0;
@@ -54,13 +87,14 @@ bool FileManager::volumeMounted() {
 }
 
 fs::Error FileManager::format() {
-    invalidateAllSlots();
+    clearSlotIndex();
+    invalidateProjectBlocks();
     return fs::volume().format();
 }
 
 fs::Error FileManager::writeProject(Project &project, int slot) {
     return writeFile(FileType::Project, slot, [&] (const char *path) {
-        auto result = writeProject(project, path);
+        auto result = writeProjectSlot(project, path, slot);
         if (result == fs::OK) {
             project.setSlot(slot);
             writeLastProject(slot);
@@ -71,7 +105,7 @@ fs::Error FileManager::writeProject(Project &project, int slot) {
 
 fs::Error FileManager::readProject(Project &project, int slot) {
     return readFile(FileType::Project, slot, [&] (const char *path) {
-        auto result = readProject(project, path);
+        auto result = readProjectSlot(project, path, slot);
         if (result == fs::OK) {
             project.setSlot(slot);
             writeLastProject(slot);
@@ -93,6 +127,63 @@ fs::Error FileManager::readLastProject(Project &project) {
     return result;
 }
 
+bool FileManager::projectCueAvailable() {
+#ifdef CONFIG_ENABLE_PROJECT_CUE
+    return true;
+#else
+    return false;
+#endif
+}
+
+fs::Error FileManager::cueProject(int slot) {
+#ifdef CONFIG_ENABLE_PROJECT_CUE
+    // the engine only applies a ready cue, so the cued project can safely be replaced while loading
+    _projectCueState = ProjectCueState::Loading;
+
+    auto result = readFile(FileType::Project, slot, [&] (const char *path) {
+        return readProject(_projectCue, path);
+    });
+
+    if (result == fs::OK) {
+        _projectCueSlot = slot;
+        _projectCueState = ProjectCueState::Ready;
+    } else {
+        clearProjectCue();
+    }
+
+    return result;
+#else
+    return fs::NOT_ENABLED;
+#endif
+}
+
+bool FileManager::projectCued() {
+    return _projectCueState == ProjectCueState::Ready;
+}
+
+bool FileManager::applyCuedProject(Project &project) {
+#ifdef CONFIG_ENABLE_PROJECT_CUE
+    if (_projectCueState != ProjectCueState::Ready) {
+        return false;
+    }
+
+    // the cued project is already deserialized, applying it only copies the project data
+    project.assign(_projectCue);
+    project.setSlot(_projectCueSlot);
+
+    clearProjectCue();
+
+    return true;
+#else
+    return false;
+#endif
+}
+
+void FileManager::clearProjectCue() {
+    _projectCueState = ProjectCueState::Empty;
+    _projectCueSlot = -1;
+}
+
 fs::Error FileManager::writeUserScale(const UserScale &userScale, int slot) {
     return writeFile(FileType::UserScale, slot, [&] (const char *path) {
         return writeUserScale(userScale, path);
@@ -106,6 +197,9 @@ fs::Error FileManager::readUserScale(UserScale &userScale, int slot) {
 }
 
 fs::Error FileManager::writeProject(const Project &project, const char *path) {
+    // path may refer to the cached project slot
+    invalidateProjectBlocks();
+
     fs::FileWriter fileWriter(path);
     if (fileWriter.error() != fs::OK) {
         return fileWriter.error();
@@ -114,10 +208,7 @@ fs::Error FileManager::writeProject(const Project &project, const char *path) {
     FileHeader header(FileType::Project, 0, project.name());
     fileWriter.write(&header, sizeof(header));
 
-    VersionedSerializedWriter writer(
-        [&fileWriter] (const void *data, size_t len) { fileWriter.write(data, len); },
-        ProjectVersion::Latest
-    );
+    VersionedSerializedWriter writer(fileWriter, ProjectVersion::Latest);
 
     project.write(writer);
 
@@ -133,10 +224,7 @@ fs::Error FileManager::readProject(Project &project, const char *path) {
     FileHeader header;
     fileReader.read(&header, sizeof(header));
 
-    VersionedSerializedReader reader(
-        [&fileReader] (void *data, size_t len) { fileReader.read(data, len); },
-        ProjectVersion::Latest
-    );
+    VersionedSerializedReader reader(fileReader, ProjectVersion::Latest);
 
     bool success = project.read(reader);
 
@@ -157,10 +245,7 @@ fs::Error FileManager::writeUserScale(const UserScale &userScale, const char *pa
     FileHeader header(FileType::UserScale, 0, userScale.name());
     fileWriter.write(&header, sizeof(header));
 
-    VersionedSerializedWriter writer(
-        [&fileWriter] (const void *data, size_t len) { fileWriter.write(data, len); },
-        ProjectVersion::Latest
-    );
+    VersionedSerializedWriter writer(fileWriter, ProjectVersion::Latest);
 
     userScale.write(writer);
 
@@ -176,10 +261,7 @@ fs::Error FileManager::readUserScale(UserScale &userScale, const char *path) {
     FileHeader header;
     fileReader.read(&header, sizeof(header));
 
-    VersionedSerializedReader reader(
-        [&fileReader] (void *data, size_t len) { fileReader.read(data, len); },
-        ProjectVersion::Latest
-    );
+    VersionedSerializedReader reader(fileReader, ProjectVersion::Latest);
 
     bool success = userScale.read(reader);
 
@@ -200,10 +282,7 @@ fs::Error FileManager::writeSettings(const Settings &settings, const char *path)
     FileHeader header(FileType::Settings, 0, "SETTINGS");
     fileWriter.write(&header, sizeof(header));
 
-    VersionedSerializedWriter writer(
-        [&fileWriter] (const void *data, size_t len) { fileWriter.write(data, len); },
-        Settings::Version
-    );
+    VersionedSerializedWriter writer(fileWriter, Settings::Version);
 
     settings.write(writer);
 
@@ -219,10 +298,7 @@ fs::Error FileManager::readSettings(Settings &settings, const char *path) {
     FileHeader header;
     fileReader.read(&header, sizeof(header));
 
-    VersionedSerializedReader reader(
-        [&fileReader] (void *data, size_t len) { fileReader.read(data, len); },
-        Settings::Version
-    );
+    VersionedSerializedReader reader(fileReader, Settings::Version);
 
     bool success = settings.read(reader);
 
@@ -235,26 +311,26 @@ fs::Error FileManager::readSettings(Settings &settings, const char *path) {
 }
 
 void FileManager::slotInfo(FileType type, int slot, SlotInfo &info) {
-    if (cachedSlot(type, slot, info)) {
-        return;
+    const auto &index = _slotIndex[int(type)];
+
+    SlotIndexEntry entry;
+    bool indexed;
+    {
+        os::InterruptLock lock;
+        indexed = index.loaded && !index.stale[slot];
+        if (indexed) {
+            entry = index.entries[slot];
+        }
     }
 
-    info.used = false;
-
-    FixedStringBuilder<32> path;
-    slotPath(path, type, slot);
-
-    if (fs::exists(path)) {
-        fs::File file(path, fs::File::Read);
-        FileHeader header;
-        size_t lenRead;
-        if (file.read(&header, sizeof(header), &lenRead) == fs::OK && lenRead == sizeof(header)) {
-            header.readName(info.name, sizeof(info.name));
-            info.used = true;
-        }
+    if (!indexed) {
+        // index not available yet
+        readSlotIndexEntry(type, slot, entry);
     }
 
-    cacheSlot(type, slot, info);
+    info.used = entry.used;
+    std::memcpy(info.name, entry.name, sizeof(entry.name));
+    info.name[sizeof(entry.name)] = '\0';
 }
 
 bool FileManager::slotUsed(FileType type, int slot) {
@@ -278,12 +354,17 @@ void FileManager::processTask() {
         uint32_t newVolumeState = fs::volume().available() ? Available : 0;
         if (newVolumeState & Available) {
             if (!(_volumeState & Mounted)) {
-                newVolumeState |= (fs::volume().mount() == fs::OK) ? Mounted : 0;
+                if (fs::volume().mount() == fs::OK) {
+                    newVolumeState |= Mounted;
+                    loadSlotIndex(FileType::Project);
+                    loadSlotIndex(FileType::UserScale);
+                }
             } else {
                 newVolumeState |= Mounted;
             }
         } else {
-            invalidateAllSlots();
+            invalidateSlotIndex();
+            invalidateProjectBlocks();
         }
 
         _volumeState = newVolumeState;
@@ -293,6 +374,8 @@ void FileManager::processTask() {
         fs::Error result = _taskExecuteCallback();
         _taskPending = 0;
         _taskResultCallback(result);
+    } else if (_volumeState & Mounted) {
+        rebuildSlotIndex();
     }
 }
 
@@ -308,7 +391,7 @@ fs::Error FileManager::writeFile(FileType type, int slot, std::function<fs::Erro
 
     auto result = write(path);
     if (result == fs::OK) {
-        invalidateSlot(type, slot);
+        updateSlotIndex(type, slot);
     }
 
     return result;
@@ -328,6 +411,80 @@ fs::Error FileManager::readFile(FileType type, int slot, std::function<fs::Error
     return result;
 }
 
+// reads from a file and hashes the data into blocks
+struct HashingFileReader {
+    fs::FileReader &fileReader;
+    fs::BlockHasher &hasher;
+
+    void read(void *data, size_t len) {
+        fileReader.read(data, len);
+        hasher.write(data, len);
+    }
+};
+
+fs::Error FileManager::writeProjectSlot(const Project &project, const char *path, int slot) {
+    size_t knownBlocks = _projectBlocks.slot == slot ? _projectBlocks.count : 0;
+    invalidateProjectBlocks();
+
+    fs::BlockFileWriter fileWriter(path, _projectBlocks.hashes.data(), _projectBlocks.hashes.size(), knownBlocks, _projectBlocks.buffers);
+    if (fileWriter.error() != fs::OK) {
+        return fileWriter.error();
+    }
+
+    FileHeader header(FileType::Project, 0, project.name());
+    fileWriter.write(&header, sizeof(header));
+
+    VersionedSerializedWriter writer(fileWriter, ProjectVersion::Latest);
+
+    project.write(writer);
+
+    auto result = fileWriter.finish();
+    if (result == fs::OK) {
+        _projectBlocks.slot = slot;
+        _projectBlocks.count = fileWriter.blockCount();
+    }
+
+    return result;
+}
+
+fs::Error FileManager::readProjectSlot(Project &project, const char *path, int slot) {
+    invalidateProjectBlocks();
+
+    fs::FileReader fileReader(path);
+    if (fileReader.error() != fs::OK) {
+        return fileReader.error();
+    }
+
+    fs::BlockHasher hasher(_projectBlocks.hashes.data(), _projectBlocks.hashes.size());
+
+    FileHeader header;
+    fileReader.read(&header, sizeof(header));
+    hasher.write(&header, sizeof(header));
+
+    HashingFileReader hashingReader = { fileReader, hasher };
+    VersionedSerializedReader reader(hashingReader, ProjectVersion::Latest);
+
+    bool success = project.read(reader);
+
+    auto error = fileReader.finish();
+    if (error == fs::OK && !success) {
+        error = fs::INVALID_CHECKSUM;
+    }
+
+    if (error == fs::OK) {
+        hasher.finish();
+        _projectBlocks.slot = slot;
+        _projectBlocks.count = hasher.blockCount();
+    }
+
+    return error;
+}
+
+void FileManager::invalidateProjectBlocks() {
+    _projectBlocks.slot = -1;
+    _projectBlocks.count = 0;
+}
+
 fs::Error FileManager::writeLastProject(int slot) {
     fs::FileWriter fileWriter("LAST.DAT");
     if (fileWriter.error() != fs::OK) {
@@ -350,40 +507,206 @@ fs::Error FileManager::readLastProject(int &slot) {
     return fileReader.finish();
 }
 
-bool FileManager::cachedSlot(FileType type, int slot, SlotInfo &info) {
-    for (auto &cachedSlotInfo : _cachedSlotInfos) {
-        if (cachedSlotInfo.ticket != 0 && cachedSlotInfo.type == type && cachedSlotInfo.slot == slot) {
-            info = cachedSlotInfo.info;
-            cachedSlotInfo.ticket = nextCachedSlotTicket();
-            return true;
+void FileManager::loadSlotIndex(FileType type) {
+    auto &index = _slotIndex[int(type)];
+    index.loaded = false;
+
+    bool valid = readSlotIndex(type);
+    if (!valid) {
+        for (auto &entry : index.entries) {
+            entry = SlotIndexEntry();
         }
     }
-    return false;
+    index.stale.reset();
+    index.dirty = !valid;
+
+    // check index against the slot directory, new or modified slot files are read in the background
+    std::bitset<SlotCount> found;
+    fs::Directory dir(fileTypeInfos[int(type)].dir);
+    while (dir.next()) {
+        int slot = slotFromFilename(type, dir.info().name());
+        if (slot >= 0) {
+            found.set(slot);
+            const auto &entry = index.entries[slot];
+            if (!entry.used || entry.size != dir.info().size() || entry.timestamp != dir.info().timestamp()) {
+                index.stale.set(slot);
+            }
+        }
+    }
+    for (int slot = 0; slot < SlotCount; ++slot) {
+        auto &entry = index.entries[slot];
+        if (entry.used && !found[slot]) {
+            entry = SlotIndexEntry();
+            index.dirty = true;
+        }
+    }
+
+    os::InterruptLock lock;
+    index.loaded = true;
+}
+
+bool FileManager::readSlotIndex(FileType type) {
+    auto &index = _slotIndex[int(type)];
+
+    FixedStringBuilder<32> path;
+    slotIndexPath(path, type);
+
+    fs::FileReader fileReader(path);
+    if (fileReader.error() != fs::OK) {
+        return false;
+    }
+
+    uint32_t magic = 0;
+    uint32_t version = 0;
+    uint32_t count = 0;
+    fileReader.read(&magic, sizeof(magic));
+    fileReader.read(&version, sizeof(version));
+    fileReader.read(&count, sizeof(count));
+    if (magic != SlotIndexMagic || version != SlotIndexVersion || count != SlotCount) {
+        return false;
+    }
+
+    uint32_t expectedHash = 0;
+    fileReader.read(index.entries.data(), sizeof(index.entries));
+    fileReader.read(&expectedHash, sizeof(expectedHash));
+    if (fileReader.finish() != fs::OK) {
+        return false;
+    }
+
+    FnvHash hash;
+    hash(index.entries.data(), sizeof(index.entries));
+    return hash.result() == expectedHash;
+}
+
+fs::Error FileManager::writeSlotIndex(FileType type) {
+    auto &index = _slotIndex[int(type)];
+    index.dirty = false;
+
+    const auto &info = fileTypeInfos[int(type)];
+    if (!fs::exists(info.dir)) {
+        fs::mkdir(info.dir);
+    }
+
+    FixedStringBuilder<32> path;
+    slotIndexPath(path, type);
+
+    fs::FileWriter fileWriter(path);
+    if (fileWriter.error() != fs::OK) {
+        return fileWriter.error();
+    }
+
+    uint32_t magic = SlotIndexMagic;
+    uint32_t version = SlotIndexVersion;
+    uint32_t count = SlotCount;
+    fileWriter.write(&magic, sizeof(magic));
+    fileWriter.write(&version, sizeof(version));
+    fileWriter.write(&count, sizeof(count));
+
+    FnvHash hash;
+    hash(index.entries.data(), sizeof(index.entries));
+    uint32_t result = hash.result();
+    fileWriter.write(index.entries.data(), sizeof(index.entries));
+    fileWriter.write(&result, sizeof(result));
+
+    return fileWriter.finish();
 }
 
-void FileManager::cacheSlot(FileType type, int slot, const SlotInfo &info) {
-    auto cachedSlotInfo = std::min_element(_cachedSlotInfos.begin(), _cachedSlotInfos.end());
-    cachedSlotInfo->type = type;
-    cachedSlotInfo->slot = slot;
-    cachedSlotInfo->info = info;
-    cachedSlotInfo->ticket = nextCachedSlotTicket();
+void FileManager::updateSlotIndex(FileType type, int slot) {
+    auto &index = _slotIndex[int(type)];
+    if (!index.loaded) {
+        return;
+    }
+
+    SlotIndexEntry entry;
+    readSlotIndexEntry(type, slot, entry);
+    setSlotIndexEntry(type, slot, entry);
+    writeSlotIndex(type);
+}
+
+void FileManager::setSlotIndexEntry(FileType type, int slot, const SlotIndexEntry &entry) {
+    auto &index = _slotIndex[int(type)];
+    os::InterruptLock lock;
+    index.entries[slot] = entry;
+    index.stale.reset(slot);
 }
 
-void FileManager::invalidateSlot(FileType type, int slot) {
-    for (auto &cachedSlotInfo : _cachedSlotInfos) {
-        if (cachedSlotInfo.ticket != 0 && cachedSlotInfo.type == type && cachedSlotInfo.slot == slot) {
-            cachedSlotInfo.ticket = 0;
+void FileManager::rebuildSlotIndex() {
+    // read one stale slot file per call to keep the file task responsive
+    for (size_t typeIndex = 0; typeIndex < _slotIndex.size(); ++typeIndex) {
+        auto type = FileType(typeIndex);
+        auto &index = _slotIndex[typeIndex];
+        if (!index.loaded) {
+            continue;
+        }
+        if (index.stale.any()) {
+            int slot = 0;
+            while (!index.stale[slot]) {
+                ++slot;
+            }
+            SlotIndexEntry entry;
+            readSlotIndexEntry(type, slot, entry);
+            setSlotIndexEntry(type, slot, entry);
+            index.dirty = true;
+            return;
+        }
+        if (index.dirty) {
+            writeSlotIndex(type);
+            return;
         }
     }
 }
 
-void FileManager::invalidateAllSlots() {
-    for (auto &cachedSlotInfo : _cachedSlotInfos) {
-        cachedSlotInfo.ticket = 0;
+void FileManager::clearSlotIndex() {
+    for (auto &index : _slotIndex) {
+        index.loaded = false;
+        for (auto &entry : index.entries) {
+            entry = SlotIndexEntry();
+        }
+        index.stale.reset();
+        index.dirty = false;
+
+        os::InterruptLock lock;
+        index.loaded = true;
     }
 }
 
-uint32_t FileManager::nextCachedSlotTicket() {
-    _cachedSlotInfoTicket = std::max(uint32_t(1), _cachedSlotInfoTicket + 1);
-    return _cachedSlotInfoTicket;
+void FileManager::invalidateSlotIndex() {
+    for (auto &index : _slotIndex) {
+        index.loaded = false;
+    }
+}
+
+void FileManager::readSlotIndexEntry(FileType type, int slot, SlotIndexEntry &entry) {
+    entry = SlotIndexEntry();
+
+    FixedStringBuilder<32> path;
+    slotPath(path, type, slot);
+
+    fs::FileInfo info;
+    if (fs::stat(path, info) != fs::OK) {
+        return;
+    }
+
+    fs::File file(path, fs::File::Read);
+    if (file.error() != fs::OK) {
+        return;
+    }
+
+    FileHeader header;
+    size_t lenRead;
+    if (file.read(&header, sizeof(header), &lenRead) != fs::OK || lenRead != sizeof(header)) {
+        return;
+    }
+
+    entry.used = 1;
+    std::memcpy(entry.name, header.name, sizeof(entry.name));
+    entry.size = file.size();
+    entry.timestamp = info.timestamp();
+
+    // data version follows the header, the data hash is stored at the end of the file
+    if (entry.size >= sizeof(header) + 2 * sizeof(uint32_t)) {
+        file.read(&entry.version, sizeof(entry.version));
+        file.seek(entry.size - sizeof(entry.hash));
+        file.read(&entry.hash, sizeof(entry.hash));
+    }
 }
@@ -6,8 +6,10 @@
 #include "Settings.h"
 
 #include "core/fs/FileSystem.h"
+#include "core/fs/BlockFileWriter.h"
 
 #include <array>
+#include <bitset>
 #include <functional>
 
 #include <cstdint>
@@ -37,8 +39,20 @@ public:
     static fs::Error writeSettings(const Settings &settings, const char *path);
     static fs::Error readSettings(Settings &settings, const char *path);
 
+    // Project cue
+    // a cued project is kept in memory in serialized form and applied to the live project
+    // by the engine at the next measure boundary
+
+    static bool projectCueAvailable();
+    static fs::Error cueProject(int slot);
+    static bool projectCued();
+    static bool applyCuedProject(Project &project);
+    static void clearProjectCue();
+
     // Slot information
 
+    static constexpr int SlotCount = 128;
+
     struct SlotInfo {
         bool used;
         char name[FileHeader::NameLength + 1];
@@ -59,24 +73,55 @@ private:
     static fs::Error writeFile(FileType type, int slot, std::function<fs::Error(const char *)> write);
     static fs::Error readFile(FileType type, int slot, std::function<fs::Error(const char *)> read);
 
+    static fs::Error writeProjectSlot(const Project &project, const char *path, int slot);
+    static fs::Error readProjectSlot(Project &project, const char *path, int slot);
+    static void invalidateProjectBlocks();
+
     static fs::Error writeLastProject(int slot);
     static fs::Error readLastProject(int &slot);
 
-    static bool cachedSlot(FileType type, int slot, SlotInfo &info);
-    static void cacheSlot(FileType type, int slot, const SlotInfo &info);
-    static void invalidateSlot(FileType type, int slot);
-    static void invalidateAllSlots();
-    static uint32_t nextCachedSlotTicket();
-
-    struct CachedSlotInfo {
-        uint32_t ticket = 0;
-        FileType type;
-        uint8_t slot;
-        SlotInfo info;
-
-        bool operator < (const CachedSlotInfo &other) const {
-            return ticket < other.ticket;
-        }
+    // Slot index
+    // name, size, timestamp, version and hash of all slot files are kept in an index file in the slot directory
+    // and loaded when the volume is mounted, so slot listings do not need to open the slot files.
+    // the index is updated by the file task and read by the ui task, entries are only accessed with interrupts
+    // disabled and while the index is loaded.
+
+    struct SlotIndexEntry {
+        uint8_t used;
+        char name[FileHeader::NameLength];
+        uint32_t size;
+        uint32_t timestamp;
+        uint32_t version;
+        uint32_t hash;
+    } __attribute__((packed));
+
+    struct SlotIndex {
+        bool loaded = false;
+        bool dirty = false;
+        // slots that need to be read from their files
+        std::bitset<SlotCount> stale;
+        std::array<SlotIndexEntry, SlotCount> entries;
+    };
+
+    static void loadSlotIndex(FileType type);
+    static bool readSlotIndex(FileType type);
+    static fs::Error writeSlotIndex(FileType type);
+    static void updateSlotIndex(FileType type, int slot);
+    static void setSlotIndexEntry(FileType type, int slot, const SlotIndexEntry &entry);
+    static void rebuildSlotIndex();
+    static void clearSlotIndex();
+    static void invalidateSlotIndex();
+    static void readSlotIndexEntry(FileType type, int slot, SlotIndexEntry &entry);
+
+    // block hashes of the last written/read project slot, used to only rewrite changed blocks
+    static constexpr size_t MaxProjectBlocks = sizeof(Project) / fs::BlockFileWriter::BlockSize + 8;
+
+    struct ProjectBlocks {
+        int slot = -1;
+        size_t count = 0;
+        std::array<uint32_t, MaxProjectBlocks> hashes;
+        // kept here instead of on the file task stack
+        fs::BlockFileWriter::Buffers buffers;
     };
 
     enum VolumeState {
@@ -87,8 +132,24 @@ private:
     static uint32_t _volumeState;
     static uint32_t _nextVolumeStateCheckTicks;
 
-    static std::array<CachedSlotInfo, 4> _cachedSlotInfos;
-    static uint32_t _cachedSlotInfoTicket;
+    // one index per slot file type (projects, user scales)
+    static std::array<SlotIndex, 2> _slotIndex;
+
+    static ProjectBlocks _projectBlocks;
+
+    enum class ProjectCueState : uint8_t {
+        Empty,
+        Loading,
+        Ready,
+    };
+
+    static volatile ProjectCueState _projectCueState;
+    static int _projectCueSlot;
+#ifdef CONFIG_ENABLE_PROJECT_CUE
+    // cued project is read ahead of time with its own user scales to not affect the live project
+    static UserScale::Array _projectCueUserScales;
+    static Project _projectCue;
+#endif
 
     static TaskExecuteCallback _taskExecuteCallback;
     static TaskResultCallback _taskResultCallback;
@@ -188,6 +188,8 @@ void NoteSequence::Step::clear() {
     setStageRepeatsMode(StageRepeatMode::Each);
 }
 
+static_assert(sizeof(NoteSequence::Step) == 2 * sizeof(uint32_t), "bulk step serialization requires steps to be the raw data words");
+
 void NoteSequence::Step::write(VersionedSerializedWriter &writer) const {
     writer.write(_data0.raw);
     writer.write(_data1.raw);
@@ -242,6 +244,7 @@ void NoteSequence::clear() {
     setRootNote(-1);
     setDivisor(12);
     setResetMeasure(0);
+    setSeed(0);
     setRunMode(Types::RunMode::Forward);
     setFirstStep(0);
     setLastStep(15);
@@ -304,8 +307,10 @@ void NoteSequence::write(VersionedSerializedWriter &writer) const {
     writer.write(_runMode.base);
     writer.write(_firstStep.base);
     writer.write(_lastStep.base);
+    writer.write(_seed);
 
-    writeArray(writer, _steps);
+    // steps are stored as their raw data words, matching their memory layout
+    writer.write(_steps.data(), sizeof(_steps));
 }
 
 void NoteSequence::read(VersionedSerializedReader &reader) {
@@ -320,6 +325,11 @@ void NoteSequence::read(VersionedSerializedReader &reader) {
     reader.read(_runMode.base);
     reader.read(_firstStep.base);
     reader.read(_lastStep.base);
+    reader.read(_seed, ProjectVersion::Version36);
 
-    readArray(reader, _steps);
+    if (reader.dataVersion() >= ProjectVersion::Version27) {
+        reader.read(_steps.data(), sizeof(_steps), 0);
+    } else {
+        readArray(reader, _steps);
+    }
 }
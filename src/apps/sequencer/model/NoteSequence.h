@@ -371,6 +371,25 @@ public:
         }
     }
 
+    // seed
+
+    int seed() const { return _seed; }
+    void setSeed(int seed) {
+        _seed = clamp(seed, 0, 9999);
+    }
+
+    void editSeed(int value, bool shift) {
+        setSeed(seed() + value * (shift ? 100 : 1));
+    }
+
+    void printSeed(StringBuilder &str) const {
+        if (seed() == 0) {
+            str("off");
+        } else {
+            str("%d", seed());
+        }
+    }
+
     // runMode
 
     Types::RunMode runMode() const { return _runMode.get(isRouted(Routing::Target::RunMode)); }
@@ -492,6 +511,7 @@ private:
     Routable<int8_t> _rootNote;
     Routable<uint16_t> _divisor;
     uint8_t _resetMeasure;
+    uint16_t _seed;
     Routable<Types::RunMode> _runMode;
     Routable<uint8_t> _firstStep;
     Routable<uint8_t> _lastStep;
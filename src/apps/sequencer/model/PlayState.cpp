@@ -279,12 +279,26 @@ void PlayState::clear() {
     _snapshot.active = false;
 }
 
+PlayState &PlayState::operator=(const PlayState &other) {
+    _trackStates = other._trackStates;
+    _songState = other._songState;
+
+    _executeLatchedRequests = other._executeLatchedRequests;
+    _hasImmediateRequests = other._hasImmediateRequests;
+    _hasSyncedRequests = other._hasSyncedRequests;
+    _hasLatchedRequests = other._hasLatchedRequests;
+
+    _snapshot = other._snapshot;
+
+    return *this;
+}
+
 void PlayState::write(VersionedSerializedWriter &writer) const {
-    writeArray(writer, _trackStates);
+    writeArray(writer, _saveState.active ? _saveState.trackStates : _trackStates);
 }
 
-void PlayState::read(VersionedSerializedReader &reader) {
-    readArray(reader, _trackStates);
+void PlayState::read(VersionedSerializedReader &reader, int trackCount) {
+    readArray(reader, _trackStates, trackCount);
     notify(Immediate);
 }
 
@@ -295,11 +309,11 @@ void PlayState::selectTrackPatternUnsafe(int track, int pattern, ExecuteType exe
     notify(executeType);
 }
 
-void PlayState::writeRouted(Routing::Target target, uint8_t tracks, int intValue, float floatValue) {
+void PlayState::writeRouted(Routing::Target target, Types::TrackBits tracks, int intValue, float floatValue) {
     bool active = intValue != 0;
 
     for (int trackIndex = 0; trackIndex < CONFIG_TRACK_COUNT; ++trackIndex) {
-        if (tracks & (1 << trackIndex)) {
+        if (tracks & (Types::TrackBits(1) << trackIndex)) {
             auto &trackState = this->trackState(trackIndex);
             switch (target) {
             case Routing::Target::Mute:
@@ -260,6 +260,9 @@ public:
 
     PlayState(Project &project);
 
+    // copies the play state but keeps the project reference and save state
+    PlayState &operator=(const PlayState &other);
+
     // mutes
 
     void muteTrack(int track, ExecuteType executeType = Immediate);
@@ -309,14 +312,23 @@ public:
 
     void clear();
 
+    // save state
+    // captures the track states so they can be written while the engine keeps modifying them
+
+    void createSaveState() {
+        _saveState.trackStates = _trackStates;
+        _saveState.active = true;
+    }
+    void releaseSaveState() { _saveState.active = false; }
+
     void write(VersionedSerializedWriter &writer) const;
-    void read(VersionedSerializedReader &reader);
+    void read(VersionedSerializedReader &reader, int trackCount);
 
     //----------------------------------------
     // Routing
     //----------------------------------------
 
-    void writeRouted(Routing::Target target, uint8_t tracks, int intValue, float floatValue);
+    void writeRouted(Routing::Target target, Types::TrackBits tracks, int intValue, float floatValue);
 
 private:
     void selectTrackPatternUnsafe(int track, int pattern, ExecuteType executeType = Immediate);
@@ -351,6 +363,11 @@ private:
         uint8_t lastTrackPatternIndex[CONFIG_TRACK_COUNT];
     } _snapshot;
 
+    struct {
+        bool active = false;
+        std::array<TrackState, CONFIG_TRACK_COUNT> trackStates;
+    } _saveState;
+
     friend class Project;
     friend class Engine;
 };
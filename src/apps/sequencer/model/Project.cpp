@@ -2,6 +2,11 @@
 #include "ProjectVersion.h"
 
 Project::Project() :
+    Project(UserScale::userScales)
+{}
+
+Project::Project(UserScale::Array &userScales) :
+    _userScales(userScales),
     _playState(*this),
     _routing(*this)
 {
@@ -41,6 +46,7 @@ void Project::clear() {
     setMidiPgmChangeEnabled(false);
     setCvGateInput(Types::CvGateInput::Off);
     setCurveCvInput(Types::CurveCvInput::Off);
+    setRandomSeed(0);
 
     _clockSetup.clear();
 
@@ -58,7 +64,7 @@ void Project::clear() {
     _routing.clear();
     _midiOutput.clear();
 
-    for (auto &userScale : UserScale::userScales) {
+    for (auto &userScale : _userScales) {
         userScale.clear();
     }
 
@@ -100,9 +106,20 @@ void Project::setTrackMode(int trackIndex, Track::TrackMode trackMode) {
     _observable.notify(TrackModeChanged);
 }
 
+void Project::createSaveState() {
+    _saveState.tempo = _tempo.base;
+    _saveState.active = true;
+    _playState.createSaveState();
+}
+
+void Project::releaseSaveState() {
+    _saveState.active = false;
+    _playState.releaseSaveState();
+}
+
 void Project::write(VersionedSerializedWriter &writer) const {
     writer.write(_name, NameLength + 1);
-    writer.write(_tempo.base);
+    writer.write(_saveState.active ? _saveState.tempo : _tempo.base);
     writer.write(_swing.base);
     _timeSignature.write(writer);
     writer.write(_syncMeasure);
@@ -115,9 +132,12 @@ void Project::write(VersionedSerializedWriter &writer) const {
     _midiInputSource.write(writer);
     writer.write(_cvGateInput);
     writer.write(_curveCvInput);
+    writer.write(_randomSeed);
 
     _clockSetup.write(writer);
 
+    uint8_t trackCount = CONFIG_TRACK_COUNT;
+    writer.write(trackCount);
     writeArray(writer, _tracks);
     writeArray(writer, _cvOutputTracks);
     writeArray(writer, _gateOutputTracks);
@@ -127,7 +147,7 @@ void Project::write(VersionedSerializedWriter &writer) const {
     _routing.write(writer);
     _midiOutput.write(writer);
 
-    writeArray(writer, UserScale::userScales);
+    writeArray(writer, _userScales);
 
     writer.write(_selectedTrackIndex);
     writer.write(_selectedPatternIndex);
@@ -161,20 +181,29 @@ bool Project::read(VersionedSerializedReader &reader) {
     }
     reader.read(_cvGateInput, ProjectVersion::Version6);
     reader.read(_curveCvInput, ProjectVersion::Version11);
+    reader.read(_randomSeed, ProjectVersion::Version36);
 
     _clockSetup.read(reader);
 
-    readArray(reader, _tracks);
+    // projects written before the track count was configurable always have 8 tracks
+    uint8_t trackCount = 8;
+    reader.read(trackCount, ProjectVersion::Version34);
+    if (trackCount > CONFIG_TRACK_COUNT) {
+        clear();
+        return false;
+    }
+
+    readArray(reader, _tracks, trackCount);
     readArray(reader, _cvOutputTracks);
     readArray(reader, _gateOutputTracks);
 
-    _song.read(reader);
-    _playState.read(reader);
+    _song.read(reader, trackCount);
+    _playState.read(reader, trackCount);
     _routing.read(reader);
     _midiOutput.read(reader);
 
     if (reader.dataVersion() >= ProjectVersion::Version5) {
-        readArray(reader, UserScale::userScales);
+        readArray(reader, _userScales);
     }
 
     reader.read(_selectedTrackIndex);
@@ -189,3 +218,52 @@ bool Project::read(VersionedSerializedReader &reader) {
 
     return success;
 }
+
+void Project::assign(const Project &other) {
+    _slot = other._slot;
+    setName(other._name);
+    _autoLoaded = other._autoLoaded;
+    _tempo = other._tempo;
+    _orinalTempo = other._orinalTempo;
+    _swing = other._swing;
+    _timeSignature = other._timeSignature;
+    _syncMeasure = other._syncMeasure;
+    _scale = other._scale;
+    _rootNote = other._rootNote;
+    _recordMode = other._recordMode;
+    _monitorMode = other._monitorMode;
+    _midiInputMode = other._midiInputMode;
+    _midiInputSource = other._midiInputSource;
+    _midiPgmChange = other._midiPgmChange;
+    _cvGateInput = other._cvGateInput;
+    _curveCvInput = other._curveCvInput;
+    _randomSeed = other._randomSeed;
+
+    _clockSetup = other._clockSetup;
+
+    for (size_t i = 0; i < _tracks.size(); ++i) {
+        auto &track = _tracks[i];
+        const auto &otherTrack = other._tracks[i];
+        track.setTrackMode(otherTrack.trackMode());
+        track.setName(otherTrack.name());
+        track = otherTrack;
+    }
+
+    _cvOutputTracks = other._cvOutputTracks;
+    _gateOutputTracks = other._gateOutputTracks;
+
+    _song = other._song;
+    _playState = other._playState;
+    _routing = other._routing;
+    _midiOutput = other._midiOutput;
+
+    if (&_userScales != &other._userScales) {
+        _userScales = other._userScales;
+    }
+
+    _selectedTrackIndex = other._selectedTrackIndex;
+    _selectedPatternIndex = other._selectedPatternIndex;
+    StringUtils::copy(_selectedTrackName, other._selectedTrackName, sizeof(_selectedTrackName));
+    _selectedNoteSequenceLayer = other._selectedNoteSequenceLayer;
+    _selectedCurveSequenceLayer = other._selectedCurveSequenceLayer;
+}
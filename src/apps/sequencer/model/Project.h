@@ -34,6 +34,8 @@ public:
     typedef std::array<uint8_t, CONFIG_CHANNEL_COUNT> GateOutputArray;
 
     Project();
+    // project using a separate set of user scales (used for reading a project without affecting the active one)
+    Project(UserScale::Array &userScales);
 
     //----------------------------------------
     // Properties
@@ -272,6 +274,21 @@ public:
         str(Types::curveCvInput(_curveCvInput));
     }
 
+    // randomSeed
+
+    int randomSeed() const { return _randomSeed; }
+    void setRandomSeed(int randomSeed) {
+        _randomSeed = clamp(randomSeed, 0, 9999);
+    }
+
+    void editRandomSeed(int value, bool shift) {
+        setRandomSeed(randomSeed() + value * (shift ? 100 : 1));
+    }
+
+    void printRandomSeed(StringBuilder &str) const {
+        str("%d", randomSeed());
+    }
+
     // curveMidiInput
 
     // clockSetup
@@ -323,11 +340,11 @@ public:
 
     // userScales
 
-    const UserScale::Array &userScales() const { return UserScale::userScales; }
-          UserScale::Array &userScales()       { return UserScale::userScales; }
+    const UserScale::Array &userScales() const { return _userScales; }
+          UserScale::Array &userScales()       { return _userScales; }
 
-    const UserScale &userScale(int index) const { return UserScale::userScales[index]; }
-          UserScale &userScale(int index)       { return UserScale::userScales[index]; }
+    const UserScale &userScale(int index) const { return _userScales[index]; }
+          UserScale &userScale(int index)       { return _userScales[index]; }
 
     // routing
 
@@ -370,6 +387,9 @@ public:
 
     bool isSelectedTrack(int index) const { return _selectedTrackIndex == index; }
 
+    // index of the first track in the bank containing the selected track (banks map onto the track buttons)
+    int trackBankOffset() const { return (_selectedTrackIndex / CONFIG_TRACK_BANK_SIZE) * CONFIG_TRACK_BANK_SIZE; }
+
     // selectedPatternIndex
 
     int selectedPatternIndex() const {
@@ -455,10 +475,28 @@ public:
 
     void setTrackMode(int trackIndex, Track::TrackMode trackMode);
 
+    // save state
+    // captures the parts of the project modified by the engine while playing (tempo, track play states),
+    // must be called with the engine locked. writing the project then uses the captured state, so it can
+    // be saved consistently without suspending the engine. track engines do not record into sequences
+    // while the save state is active. routed values are written by the engine but never serialized.
+
+    void createSaveState();
+    void releaseSaveState();
+    bool saveStateActive() const { return _saveState.active; }
+
     void write(VersionedSerializedWriter &writer) const;
     bool read(VersionedSerializedReader &reader);
 
+    // copies all project data from another project (without any deserialization),
+    // does not notify watchers as it is called from the engine task (see notifyRead())
+    void assign(const Project &other);
+
+    // notifies watchers that the project was read, used after assign()
+    void notifyRead() { _observable.notify(ProjectRead); }
+
 private:
+    UserScale::Array &_userScales;
     uint8_t _slot = uint8_t(-1);
     char _name[NameLength + 1];
     mutable uint8_t _autoLoaded = 0;
@@ -476,6 +514,7 @@ private:
     bool _midiPgmChange;
     Types::CvGateInput _cvGateInput;
     Types::CurveCvInput _curveCvInput;
+    uint16_t _randomSeed;
 
     ClockSetup _clockSetup;
     TrackArray _tracks;
@@ -493,5 +532,10 @@ private:
     NoteSequence::Layer _selectedNoteSequenceLayer = NoteSequence::Layer(0);
     CurveSequence::Layer _selectedCurveSequenceLayer = CurveSequence::Layer(0);
 
+    struct {
+        bool active = false;
+        float tempo;
+    } _saveState;
+
     Observable<Event, 2> _observable;
 };
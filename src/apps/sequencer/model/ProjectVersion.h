@@ -1,3 +1,5 @@
+#pragma once
+
 enum ProjectVersion {
     // added NoteTrack::cvUpdateMode
     Version4 = 4,
@@ -96,6 +98,27 @@ enum ProjectVersion {
     // added Track::name and expand noteRetrigger to 3 bits and nprobability to 6bits
     Version33 = 33,
 
+    // added Project::trackCount
+    // expanded Song::Slot::patterns and Song::Slot::mutes to Project::trackCount entries
+    // expanded Routing::Route::tracks to 32 bits
+    Version34 = 34,
+
+    // added ClockSetup::slaveSync
+    // added ClockSetup::slaveResponse
+    Version35 = 35,
+
+    // added Project::randomSeed
+    // added NoteSequence::seed
+    // added CurveSequence::seed
+    Version36 = 36,
+
+    // added CurveTrack::outputMode
+    Version37 = 37,
+
+    // added Routing::routeCount
+    // expanded Routing::routes to Routing::routeCount entries
+    Version38 = 38,
+
     // automatically derive latest version
     Last,
     Latest = Last - 1,
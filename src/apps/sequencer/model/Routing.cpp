@@ -93,7 +93,11 @@ void Routing::Route::write(VersionedSerializedWriter &writer) const {
 
 void Routing::Route::read(VersionedSerializedReader &reader) {
     reader.readEnum(_target, targetSerialize);
-    reader.read(_tracks);
+    if (reader.dataVersion() < ProjectVersion::Version34) {
+        reader.readAs<uint8_t>(_tracks);
+    } else {
+        reader.read(_tracks);
+    }
     reader.read(_min);
     reader.read(_max);
     reader.read(_source);
@@ -129,6 +133,7 @@ void Routing::clear() {
     for (auto &route : _routes) {
         route.clear();
     }
+    setDirty();
 }
 
 int Routing::findEmptyRoute() const {
@@ -143,7 +148,7 @@ int Routing::findEmptyRoute() const {
 int Routing::findRoute(Target target, int trackIndex) const {
     for (size_t i = 0; i < _routes.size(); ++i) {
         const auto &route = _routes[i];
-        if (route.active() && route.target() == target && (!Routing::isTrackTarget(target) || route.tracks() & (1<<trackIndex))) {
+        if (route.active() && route.target() == target && (!Routing::isTrackTarget(target) || route.tracks() & (Types::TrackBits(1) << trackIndex))) {
             return i;
         }
     }
@@ -179,7 +184,7 @@ int Routing::checkRouteConflict(const Route &editedRoute, const Route &existingR
     return -1;
 }
 
-void Routing::writeTarget(Target target, uint8_t tracks, float normalized) {
+void Routing::writeTarget(Target target, Types::TrackBits tracks, float normalized) {
     float floatValue = denormalizeTargetValue(target, normalized);
     int intValue = std::round(floatValue);
 
@@ -189,7 +194,7 @@ void Routing::writeTarget(Target target, uint8_t tracks, float normalized) {
         _project.playState().writeRouted(target, tracks, intValue, floatValue);
     } else if (isTrackTarget(target) || isSequenceTarget(target)) {
         for (int trackIndex = 0; trackIndex < CONFIG_TRACK_COUNT; ++trackIndex) {
-            if (tracks & (1<<trackIndex)) {
+            if (tracks & (Types::TrackBits(1) << trackIndex)) {
                 auto &track = _project.track(trackIndex);
                 switch (track.trackMode()) {
                 case Track::TrackMode::Note:
@@ -224,21 +229,35 @@ void Routing::writeTarget(Target target, uint8_t tracks, float normalized) {
 }
 
 void Routing::write(VersionedSerializedWriter &writer) const {
+    writer.write(uint8_t(_routes.size()));
     writeArray(writer, _routes);
 }
 
 void Routing::read(VersionedSerializedReader &reader) {
-    readArray(reader, _routes);
+    uint8_t routeCount = LegacyRouteCount;
+    reader.read(routeCount, ProjectVersion::Version38);
+
+    for (int routeIndex = 0; routeIndex < routeCount; ++routeIndex) {
+        if (routeIndex < CONFIG_ROUTE_COUNT) {
+            _routes[routeIndex].read(reader);
+        } else {
+            // skip routes not supported by this build
+            Route route;
+            route.read(reader);
+        }
+    }
+
+    setDirty();
 }
 
-static std::array<uint8_t, size_t(Routing::Target::Last)> routedSet;
-static_assert(sizeof(uint8_t) * 8 >= CONFIG_TRACK_COUNT, "track bits do not fit");
+static std::array<Types::TrackBits, size_t(Routing::Target::Last)> routedSet;
+static_assert(sizeof(Types::TrackBits) * 8 >= CONFIG_TRACK_COUNT, "track bits do not fit");
 
 bool Routing::isRouted(Target target, int trackIndex) {
     size_t targetIndex = size_t(target);
     if (isPerTrackTarget(target)) {
         if (trackIndex >= 0 && trackIndex < CONFIG_TRACK_COUNT) {
-            return (routedSet[targetIndex] & (1 << trackIndex)) != 0;
+            return (routedSet[targetIndex] & (Types::TrackBits(1) << trackIndex)) != 0;
         }
     } else {
         return routedSet[targetIndex] != 0;
@@ -246,7 +265,7 @@ bool Routing::isRouted(Target target, int trackIndex) {
     return false;
 }
 
-void Routing::setRouted(Target target, uint8_t tracks, bool routed) {
+void Routing::setRouted(Target target, Types::TrackBits tracks, bool routed) {
     size_t targetIndex = size_t(target);
     if (isPerTrackTarget(target)) {
         if (routed) {
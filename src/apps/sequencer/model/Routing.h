@@ -397,15 +397,15 @@ public:
 
         // tracks
 
-        uint8_t tracks() const { return isPerTrackTarget(_target) ? _tracks : 0; }
-        void setTracks(uint8_t tracks) {
+        Types::TrackBits tracks() const { return isPerTrackTarget(_target) ? _tracks : 0; }
+        void setTracks(Types::TrackBits tracks) {
             if (isPerTrackTarget(_target)) {
                 _tracks = tracks;
             }
         }
 
         void toggleTrack(int trackIndex) {
-            uint8_t trackBit = (1<<trackIndex);
+            Types::TrackBits trackBit = Types::TrackBits(1) << trackIndex;
             if (tracks() & trackBit) {
                 setTracks(tracks() & ~trackBit);
             } else {
@@ -416,7 +416,7 @@ public:
         void printTracks(StringBuilder &str) const {
             if (isPerTrackTarget(_target)) {
                 for (int i = 0; i < CONFIG_TRACK_COUNT; ++i) {
-                    str("%c", (_tracks & (1<<i)) ? 'X' : '-');
+                    str("%c", (_tracks & (Types::TrackBits(1) << i)) ? 'X' : '-');
                 }
             } else {
                 str("n/a");
@@ -500,7 +500,7 @@ public:
 
     private:
         Target _target;
-        int8_t _tracks;
+        Types::TrackBits _tracks;
         float _min; // TODO make these int16_t
         float _max;
         Source _source;
@@ -530,26 +530,38 @@ public:
 
     Routing(Project &project);
 
+    // copies the routes but keeps the project reference
+    Routing &operator=(const Routing &other) {
+        _routes = other._routes;
+        setDirty();
+        return *this;
+    }
+
     void clear();
 
     int findEmptyRoute() const;
     int findRoute(Target target, int trackIndex) const;
     int checkRouteConflict(const Route &editedRoute, const Route &existingRoute) const;
 
-    void writeTarget(Target target, uint8_t tracks, float normalized);
+    void writeTarget(Target target, Types::TrackBits tracks, float normalized);
 
     void write(VersionedSerializedWriter &writer) const;
     void read(VersionedSerializedReader &reader);
 
+    // routes are marked dirty when changed, the routing engine rebuilds its active routes from them
     bool isDirty() const { return _dirty; }
+    void setDirty() { _dirty = true; }
     void clearDirty() { _dirty = false; }
 
     // global state for keeping active set of routed targets
     static bool isRouted(Target target, int trackIndex = -1);
-    static void setRouted(Target target, uint8_t tracks, bool routed);
+    static void setRouted(Target target, Types::TrackBits tracks, bool routed);
     static void printRouted(StringBuilder &str, Target target, int trackIndex = -1);
 
 private:
+    // number of routes in projects before Version38
+    static constexpr int LegacyRouteCount = 16;
+
     static float normalizeTargetValue(Target target, float value);
     static float denormalizeTargetValue(Target target, float normalized);
     static std::pair<float, float> normalizedDefaultRange(Target target);
@@ -558,7 +570,7 @@ private:
 
     Project &_project;
     RouteArray _routes;
-    bool _dirty;
+    bool _dirty = true;
 };
 
 // Routable parameters store both a base and routed value.
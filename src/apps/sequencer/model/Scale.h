@@ -30,6 +30,9 @@ public:
 
     virtual int notesPerOctave() const = 0;
 
+    // changes whenever the note mapping changes, builtin scales never change
+    virtual uint32_t revision() const { return 0; }
+
     static int Count;
     static const Scale &get(int index);
     static const char *name(int index);
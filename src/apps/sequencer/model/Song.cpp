@@ -5,20 +5,28 @@
 // Song::Slot
 
 void Song::Slot::clear() {
-    _patterns = 0;
+    _patterns.fill(0);
     _mutes = 0;
     _repeats = 1;
 }
 
 void Song::Slot::write(VersionedSerializedWriter &writer) const {
-    writer.write(_patterns);
+    for (auto patterns : _patterns) {
+        writer.write(patterns);
+    }
     writer.write(_mutes);
     writer.write(_repeats);
 }
 
-void Song::Slot::read(VersionedSerializedReader &reader) {
-    reader.read(_patterns);
-    reader.read(_mutes, ProjectVersion::Version25);
+void Song::Slot::read(VersionedSerializedReader &reader, int trackCount) {
+    for (int i = 0; i < (trackCount + 7) / 8; ++i) {
+        reader.read(_patterns[i]);
+    }
+    if (reader.dataVersion() < ProjectVersion::Version34) {
+        reader.readAs<uint8_t>(_mutes, ProjectVersion::Version25);
+    } else {
+        reader.read(_mutes);
+    }
     reader.read(_repeats);
 }
 
@@ -26,7 +34,7 @@ void Song::Slot::read(VersionedSerializedReader &reader) {
 
 void Song::chainPattern(int pattern) {
     if (!isFull()) {
-        if (_slotCount > 0 && slot(_slotCount - 1)._patterns == Slot::fillPatterns(pattern)) {
+        if (_slotCount > 0 && slot(_slotCount - 1).isPattern(pattern)) {
             editRepeats(_slotCount - 1, 1);
         } else {
             slot(_slotCount).clear();
@@ -132,11 +140,10 @@ void Song::write(VersionedSerializedWriter &writer) const {
     writer.write(_slotCount);
 }
 
-void Song::read(VersionedSerializedReader &reader) {
-    if (reader.dataVersion() < ProjectVersion::Version18) {
-        readArray(reader, _slots, 16);
-    } else {
-        readArray(reader, _slots);
+void Song::read(VersionedSerializedReader &reader, int trackCount) {
+    int slotCount = reader.dataVersion() < ProjectVersion::Version18 ? 16 : CONFIG_SONG_SLOT_COUNT;
+    for (int i = 0; i < slotCount; ++i) {
+        _slots[i].read(reader, trackCount);
     }
 
     reader.read(_slotCount);
@@ -2,6 +2,7 @@
 
 #include "Config.h"
 
+#include "Types.h"
 #include "Serialize.h"
 
 #include "core/math/Math.h"
@@ -19,7 +20,7 @@ public:
     class Slot {
     public:
         int pattern(int trackIndex) const {
-            return (_patterns >> (trackIndex << 2)) & 0xf;
+            return (_patterns[trackIndex >> 3] >> ((trackIndex & 0x7) << 2)) & 0xf;
         }
 
         bool mute(int trackIndex) const {
@@ -31,9 +32,12 @@ public:
         void clear();
 
         void write(VersionedSerializedWriter &writer) const;
-        void read(VersionedSerializedReader &reader);
+        void read(VersionedSerializedReader &reader, int trackCount);
 
     private:
+        // patterns are stored as 4 bits per track, 8 tracks per word
+        static constexpr int PatternWords = (CONFIG_TRACK_COUNT + 7) / 8;
+
         static uint32_t fillPatterns(int pattern) {
             uint32_t patterns = pattern & 0xf;
             patterns |= patterns << 4;
@@ -42,19 +46,28 @@ public:
             return patterns;
         }
 
+        bool isPattern(int pattern) const {
+            for (auto patterns : _patterns) {
+                if (patterns != fillPatterns(pattern)) {
+                    return false;
+                }
+            }
+            return true;
+        }
+
         void setPattern(int trackIndex, int pattern) {
             pattern = clamp(pattern, 0, CONFIG_PATTERN_COUNT - 1);
-            uint32_t patterns = _patterns & ~(0xf << (trackIndex << 2));
-            patterns |= (pattern & 0xf) << (trackIndex << 2);
-            _patterns = patterns;
+            int shift = (trackIndex & 0x7) << 2;
+            uint32_t &patterns = _patterns[trackIndex >> 3];
+            patterns = (patterns & ~(uint32_t(0xf) << shift)) | (uint32_t(pattern & 0xf) << shift);
         }
 
         void setPattern(int pattern) {
-            _patterns = fillPatterns(pattern);
+            _patterns.fill(fillPatterns(pattern));
         }
 
         void setMute(int trackIndex, bool mute) {
-            uint8_t bit = 0x1 << trackIndex;
+            Types::TrackBits bit = Types::TrackBits(1) << trackIndex;
             _mutes = (_mutes & ~bit) | (mute ? bit : 0);
         }
 
@@ -66,8 +79,8 @@ public:
             _repeats = clamp(repeats, 1, 128);
         }
 
-        uint32_t _patterns;
-        uint8_t _mutes;
+        std::array<uint32_t, PatternWords> _patterns;
+        Types::TrackBits _mutes;
         uint8_t _repeats;
 
         friend class Song;
@@ -109,7 +122,7 @@ public:
     void clear();
 
     void write(VersionedSerializedWriter &writer) const;
-    void read(VersionedSerializedReader &reader);
+    void read(VersionedSerializedReader &reader, int trackCount);
 
 private:
     std::array<Slot, CONFIG_SONG_SLOT_COUNT> _slots;
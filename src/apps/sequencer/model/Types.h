@@ -9,6 +9,11 @@
 
 class Types {
 public:
+    // TrackBits
+
+    // one bit per track, see CONFIG_TRACK_COUNT
+    typedef uint32_t TrackBits;
+
     // MonitorMode
 
     enum class MonitorMode : uint8_t {
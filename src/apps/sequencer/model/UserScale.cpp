@@ -3,6 +3,8 @@
 
 UserScale::Array UserScale::userScales;
 
+uint32_t UserScale::_nextRevision = 0;
+
 UserScale::UserScale() :
     Scale("")
 {
@@ -21,6 +23,7 @@ void UserScale::clearItems() {
     if (_mode == Mode::Voltage) {
         _items[1] = 1000;
     }
+    touch();
 }
 
 void UserScale::write(VersionedSerializedWriter &writer) const {
@@ -51,5 +54,7 @@ bool UserScale::read(VersionedSerializedReader &reader) {
         clear();
     }
 
+    touch();
+
     return success;
 }
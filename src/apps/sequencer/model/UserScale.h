@@ -60,6 +60,7 @@ public:
         if (mode != _mode) {
             _mode = mode;
             clearItems();
+            touch();
         }
     }
 
@@ -76,6 +77,7 @@ public:
     int size() const { return _size; }
     void setSize(int size) {
         _size = clamp(size, _mode == Mode::Chromatic ? 1 : 2, CONFIG_USER_SCALE_SIZE);
+        touch();
     }
 
     void editSize(int value, bool shift) {
@@ -103,6 +105,7 @@ public:
         case Mode::Last:
             break;
         }
+        touch();
     }
 
     void editItem(int index, int value, int shift) {
@@ -195,6 +198,8 @@ public:
         return _mode == Mode::Chromatic ? _size : _size - 1;
     }
 
+    uint32_t revision() const override { return _revision; }
+
     static Array userScales;
 
 private:
@@ -277,6 +282,9 @@ private:
         return octave * (_size - 1) + index;
     }
 
+    // revisions are unique across all user scales, so copying a scale also changes the revision
+    void touch() { _revision = ++_nextRevision; }
+
     float octaveRangeVolts() const {
         return (_items[_size - 1] - _items[0]) * (1.f / 1000.f);
     }
@@ -285,4 +293,7 @@ private:
     Mode _mode;
     uint8_t _size;
     ItemArray _items;
+    uint32_t _revision = 0;
+
+    static uint32_t _nextRevision;
 };
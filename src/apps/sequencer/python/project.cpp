@@ -29,6 +29,29 @@ static void loadProject(Project &project, const std::string &filename) {
     }
 }
 
+// Routes are exposed by reference to their routing, so that changing them marks the routing dirty
+// and the routing engine rebuilds its active routes.
+struct RouteRef {
+    RouteRef(Routing &routing, int index) : routing(routing), index(index) {}
+
+    const Routing::Route &route() const { return routing.route(index); }
+    Routing::Route &editRoute() const {
+        routing.setDirty();
+        return routing.route(index);
+    }
+
+    Routing &routing;
+    int index;
+};
+
+struct CvSourceRef : public RouteRef {
+    using RouteRef::RouteRef;
+};
+
+struct MidiSourceRef : public RouteRef {
+    using RouteRef::RouteRef;
+};
+
 static void saveProject(const Project &project, const std::string &filename) {
     std::ofstream ofs(filename);
     if (!ofs.good()) {
@@ -570,7 +593,7 @@ void register_project(py::module &m) {
         .def_property_readonly("routes", [] (Routing &routing) {
             py::list result;
             for (int i = 0; i < CONFIG_ROUTE_COUNT; ++i) {
-                result.append(&routing.route(i));
+                result.append(RouteRef(routing, i));
             }
             return result;
         })
@@ -627,20 +650,35 @@ void register_project(py::module &m) {
         .export_values()
     ;
 
-    py::class_<Routing::CvSource> cvSource(routing, "CvSource");
+    py::class_<CvSourceRef> cvSource(routing, "CvSource");
     cvSource
-        .def_property("range", &Routing::CvSource::range, &Routing::CvSource::setRange)
-        .def("clear", &Routing::CvSource::clear)
+        .def_property("range",
+            [] (const CvSourceRef &ref) { return ref.route().cvSource().range(); },
+            [] (const CvSourceRef &ref, Types::VoltageRange range) { ref.editRoute().cvSource().setRange(range); }
+        )
+        .def("clear", [] (const CvSourceRef &ref) { ref.editRoute().cvSource().clear(); })
     ;
 
-    py::class_<Routing::MidiSource> midiSource(routing, "MidiSource");
+    py::class_<MidiSourceRef> midiSource(routing, "MidiSource");
     midiSource
-        .def_property_readonly("source", [] (Routing::MidiSource &midiSource) { return &midiSource.source(); })
-        .def_property("event", &Routing::MidiSource::event, &Routing::MidiSource::setEvent)
-        .def_property("controlNumber", &Routing::MidiSource::controlNumber, &Routing::MidiSource::setControlNumber)
-        .def_property("note", &Routing::MidiSource::note, &Routing::MidiSource::setNote)
-        .def_property("noteRange", &Routing::MidiSource::noteRange, &Routing::MidiSource::setNoteRange)
-        .def("clear", &Routing::MidiSource::clear)
+        .def_property_readonly("source", [] (const MidiSourceRef &ref) { return &ref.editRoute().midiSource().source(); })
+        .def_property("event",
+            [] (const MidiSourceRef &ref) { return ref.route().midiSource().event(); },
+            [] (const MidiSourceRef &ref, Routing::MidiSource::Event event) { ref.editRoute().midiSource().setEvent(event); }
+        )
+        .def_property("controlNumber",
+            [] (const MidiSourceRef &ref) { return ref.route().midiSource().controlNumber(); },
+            [] (const MidiSourceRef &ref, int controlNumber) { ref.editRoute().midiSource().setControlNumber(controlNumber); }
+        )
+        .def_property("note",
+            [] (const MidiSourceRef &ref) { return ref.route().midiSource().note(); },
+            [] (const MidiSourceRef &ref, int note) { ref.editRoute().midiSource().setNote(note); }
+        )
+        .def_property("noteRange",
+            [] (const MidiSourceRef &ref) { return ref.route().midiSource().noteRange(); },
+            [] (const MidiSourceRef &ref, int noteRange) { ref.editRoute().midiSource().setNoteRange(noteRange); }
+        )
+        .def("clear", [] (const MidiSourceRef &ref) { ref.editRoute().midiSource().clear(); })
     ;
 
     py::enum_<Routing::MidiSource::Event> event(midiSource, "Event");
@@ -655,17 +693,32 @@ void register_project(py::module &m) {
         .export_values()
     ;
 
-    py::class_<Routing::Route> route(routing, "Route");
+    py::class_<RouteRef> route(routing, "Route");
     route
-        .def_property("target", &Routing::Route::target, &Routing::Route::setTarget)
-        .def_property("tracks", &Routing::Route::tracks, &Routing::Route::setTracks)
-        .def("toggleTrack", &Routing::Route::toggleTrack, "trackIndex"_a)
-        .def_property("min", &Routing::Route::min, &Routing::Route::setMin)
-        .def_property("max", &Routing::Route::max, &Routing::Route::setMax)
-        .def_property("source", &Routing::Route::source, &Routing::Route::setSource)
-        .def_property_readonly("cvSource", [] (Routing::Route &route) { return &route.cvSource(); })
-        .def_property_readonly("midiSource", [] (Routing::Route &route) { return &route.midiSource(); })
-        .def("clear", &Routing::Route::clear)
+        .def_property("target",
+            [] (const RouteRef &ref) { return ref.route().target(); },
+            [] (const RouteRef &ref, Routing::Target target) { ref.editRoute().setTarget(target); }
+        )
+        .def_property("tracks",
+            [] (const RouteRef &ref) { return ref.route().tracks(); },
+            [] (const RouteRef &ref, Types::TrackBits tracks) { ref.editRoute().setTracks(tracks); }
+        )
+        .def("toggleTrack", [] (const RouteRef &ref, int trackIndex) { ref.editRoute().toggleTrack(trackIndex); }, "trackIndex"_a)
+        .def_property("min",
+            [] (const RouteRef &ref) { return ref.route().min(); },
+            [] (const RouteRef &ref, float min) { ref.editRoute().setMin(min); }
+        )
+        .def_property("max",
+            [] (const RouteRef &ref) { return ref.route().max(); },
+            [] (const RouteRef &ref, float max) { ref.editRoute().setMax(max); }
+        )
+        .def_property("source",
+            [] (const RouteRef &ref) { return ref.route().source(); },
+            [] (const RouteRef &ref, Routing::Source source) { ref.editRoute().setSource(source); }
+        )
+        .def_property_readonly("cvSource", [] (const RouteRef &ref) { return CvSourceRef(ref.routing, ref.index); })
+        .def_property_readonly("midiSource", [] (const RouteRef &ref) { return MidiSourceRef(ref.routing, ref.index); })
+        .def("clear", [] (const RouteRef &ref) { ref.editRoute().clear(); })
     ;
 
     // ------------------------------------------------------------------------
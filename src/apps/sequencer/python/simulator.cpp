@@ -1,4 +1,5 @@
 #include "sim/Simulator.h"
+#include "sim/OfflineRenderer.h"
 
 #include <pybind11/pybind11.h>
 
@@ -21,6 +22,7 @@ void register_simulator(py::module &m) {
         .def("setDio", &Simulator::setDio)
         .def("sendMidi", &Simulator::sendMidi)
         .def("screenshot", &Simulator::screenshot)
+        .def_property("offline", &Simulator::offline, &Simulator::setOffline)
         .def_property_readonly("targetState", &Simulator::targetState, py::return_value_policy::reference)
     ;
 
@@ -36,4 +38,18 @@ void register_simulator(py::module &m) {
         .def("loadFromFile", &TargetTrace::loadFromFile)
         .def("saveToText", &TargetTrace::saveToText)
     ;
+
+    // ------------------------------------------------------------------------
+    // OfflineRenderer
+    // ------------------------------------------------------------------------
+
+    py::class_<OfflineRenderer> offlineRenderer(m, "OfflineRenderer", py::dynamic_attr());
+    offlineRenderer
+        .def(py::init<Simulator &>(), py::keep_alive<1, 2>())
+
+        .def("render", &OfflineRenderer::render)
+        .def("saveToFile", &OfflineRenderer::saveToFile)
+        .def("saveToText", &OfflineRenderer::saveToText)
+        .def_property_readonly("targetTrace", &OfflineRenderer::targetTrace, py::return_value_policy::reference)
+    ;
 }
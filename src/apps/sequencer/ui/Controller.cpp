@@ -14,3 +14,7 @@ Controller::~Controller() {
 bool Controller::sendMidi(uint8_t cable, const MidiMessage &message) {
     return _manager.sendMidi(cable, message);
 }
+
+uint32_t Controller::sendMidiAvailable() const {
+    return _manager.sendMidiAvailable();
+}
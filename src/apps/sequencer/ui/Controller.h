@@ -29,6 +29,8 @@ public:
 
 protected:
     bool sendMidi(uint8_t cable, const MidiMessage &message);
+    // number of messages that can currently be sent
+    uint32_t sendMidiAvailable() const;
 
     ControllerManager &_manager;
     Model &_model;
@@ -65,3 +65,7 @@ bool ControllerManager::recvMidi(MidiPort port, uint8_t cable, const MidiMessage
 bool ControllerManager::sendMidi(uint8_t cable, const MidiMessage &message) {
     return _engine.sendMidi(_port, cable, message);
 }
+
+uint32_t ControllerManager::sendMidiAvailable() const {
+    return _engine.usbMidiTxAvailable();
+}
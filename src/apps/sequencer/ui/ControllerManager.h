@@ -28,6 +28,7 @@ public:
 
 private:
     bool sendMidi(uint8_t cable, const MidiMessage &message);
+    uint32_t sendMidiAvailable() const;
 
     Model &_model;
     Engine &_engine;
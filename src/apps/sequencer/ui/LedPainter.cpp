@@ -14,16 +14,16 @@
 // green -> active
 // red -> inactive
 
-void LedPainter::drawTrackGatesAndSelectedTrack(Leds &leds, const Engine &engine, const PlayState &playState, int selectedTrack) {
+void LedPainter::drawTrackGatesAndSelectedTrack(Leds &leds, const Engine &engine, const PlayState &playState, int trackOffset, int selectedTrack) {
     bool blink = (os::ticks() % os::time::ms(200)) < os::time::ms(100);
 
     for (int track = 0; track < 8; ++track) {
-        const auto &trackEngine = engine.trackEngine(track);
-        const auto &trackState = playState.trackState(track);
+        const auto &trackEngine = engine.trackEngine(trackOffset + track);
+        const auto &trackState = playState.trackState(trackOffset + track);
 
         bool activity = trackEngine.activity();
         bool mute = (trackState.hasMuteRequest() && trackState.mute() != trackState.requestedMute()) ? blink : trackEngine.mute();
-        bool selected = track == selectedTrack;
+        bool selected = trackOffset + track == selectedTrack;
 
         if (selected) {
             if (mute) {
@@ -41,8 +41,8 @@ void LedPainter::drawTrackGatesAndSelectedTrack(Leds &leds, const Engine &engine
     }
 }
 
-void LedPainter::drawTrackGates(Leds &leds, const Engine &engine, const PlayState &playState) {
-    drawTrackGatesAndSelectedTrack(leds, engine, playState, -1);
+void LedPainter::drawTrackGates(Leds &leds, const Engine &engine, const PlayState &playState, int trackOffset) {
+    drawTrackGatesAndSelectedTrack(leds, engine, playState, trackOffset, -1);
 }
 
 void LedPainter::drawNoteSequenceGateAndCurrentStep(Leds &leds, const NoteSequence &sequence, int stepOffset, int currentStep) {
@@ -9,8 +9,8 @@ class NoteSequence;
 
 class LedPainter {
 public:
-    static void drawTrackGatesAndSelectedTrack(Leds &leds, const Engine &engine, const PlayState &playState, int selectedTrack);
-    static void drawTrackGates(Leds &leds, const Engine &engine, const PlayState &playState);
+    static void drawTrackGatesAndSelectedTrack(Leds &leds, const Engine &engine, const PlayState &playState, int trackOffset, int selectedTrack);
+    static void drawTrackGates(Leds &leds, const Engine &engine, const PlayState &playState, int trackOffset);
 
     static void drawNoteSequenceGateAndCurrentStep(Leds &leds, const NoteSequence &sequence, int stepOffset, int currentStep);
 
@@ -9,6 +9,9 @@
 
 #include "model/Model.h"
 
+PROFILER_INTERVAL(uiUpdate, "ui update")
+PROFILER_INTERVAL(lcdDraw, "lcd draw")
+
 Ui::Ui(Model &model, Engine &engine, Lcd &lcd, ButtonLedMatrix &blm, Encoder &encoder, Settings &settings) :
         _model(model),
         _engine(engine),
@@ -46,11 +49,10 @@ void Ui::init() {
     _pageManager.push(&_pages.startup);
 
     _engine.setMidiReceiveHandler([this] (MidiPort port, uint8_t cable, const MidiMessage &message) {
-        if (!_receiveMidiEvents.writable()) {
-            DBG("ui midi buffer overflow");
-            _receiveMidiEvents.read();
+        if (!_receiveMidiEvents.write({ port, cable, message })) {
+            // the engine is the producer and cannot drop the oldest event, drop the new one instead
+            _engine.midiReceiveDropped();
         }
-        _receiveMidiEvents.write({ port, cable, message });
         return port == MidiPort::UsbMidi && _controllerManager.isConnected();
     });
 
@@ -73,10 +75,17 @@ void Ui::init() {
 }
 
 void Ui::update() {
+    PROFILER_INTERVAL_SCOPE(uiUpdate)
+
     handleKeys();
     handleEncoder();
     handleMidi();
 
+    // reset pages after the engine applied a cued project
+    if (_engine.checkProjectCueApplied()) {
+        _model.project().notifyRead();
+    }
+
     // abort if track engines are not consistent with model
     if (!_engine.trackEnginesConsistent()) {
         return;
@@ -98,7 +107,9 @@ void Ui::update() {
         } else {
             _screensaver.on();
         }
+        PROFILER_INTERVAL_BEGIN(lcdDraw)
         _lcd.draw(_frameBuffer.data());
+        PROFILER_INTERVAL_END(lcdDraw)
         _lastFrameBufferUpdateTicks += intervalTicks;
     }
 
@@ -183,8 +194,8 @@ void Ui::handleEncoder() {
 }
 
 void Ui::handleMidi() {
-    while (_receiveMidiEvents.readable()) {
-        auto receiveEvent = _receiveMidiEvents.read();
+    ReceiveMidiEvent receiveEvent;
+    while (_receiveMidiEvents.readAndReplace(receiveEvent)) {
         if (!_controllerManager.recvMidi(receiveEvent.port, receiveEvent.cable, receiveEvent.message)) {
             // only process events from cable 0
             if (receiveEvent.cable == 0) {
@@ -17,7 +17,7 @@
 
 #include "core/gfx/FrameBuffer.h"
 #include "core/gfx/Canvas.h"
-#include "core/utils/RingBuffer.h"
+#include "core/utils/SpscQueue.h"
 #include "core/midi/MidiMessage.h"
 
 #include "engine/Engine.h"
@@ -53,7 +53,7 @@ private:
         uint8_t cable;
         MidiMessage message;
     };
-    RingBuffer<ReceiveMidiEvent, 16> _receiveMidiEvents;
+    SpscQueue<ReceiveMidiEvent, 16> _receiveMidiEvents;
 
     uint8_t _frameBufferData[CONFIG_LCD_WIDTH * CONFIG_LCD_HEIGHT];
     FrameBuffer8bit _frameBuffer;
@@ -92,6 +92,9 @@ struct RangeMap {
     }
 };
 
+// usb midi transmit queue entries left for the engine (midi output of tracks)
+static constexpr int UsbMidiTxReserve = 32;
+
 static const RangeMap curveMinMaxRangeMap = { { 0, 0 }, { 255, 7 } };
 
 static const RangeMap *curveSequenceLayerRangeMap[] = {
@@ -177,13 +180,38 @@ void LaunchpadController::update() {
 
      _noteStyle = _userSettings.get<LaunchpadNoteStyle>(SettingLaunchpadNoteStyle)->getValue();
 
+    // skip frames while usb midi is congested, the frame rate drops to what the connection can transfer
+    int available = int(sendMidiAvailable()) - UsbMidiTxReserve;
+    if (available <= 0) {
+        return;
+    }
+
     _device->clearLeds();
 
     CALL_MODE_FUNCTION(_mode, Draw)
 
     globalDraw();
 
-    _device->syncLeds();
+    // leds not sent are still out of sync and get sent with the next frame,
+    // start left of the playhead to clear its last position first
+    _device->syncLeds(available, (playheadColumn() + 7) % 8);
+}
+
+int LaunchpadController::playheadColumn() const {
+    const auto &trackEngine = _engine.selectedTrackEngine();
+    int currentStep = -1;
+    switch (trackEngine.trackMode()) {
+    case Track::TrackMode::Note:
+        currentStep = trackEngine.as<NoteTrackEngine>().currentStep();
+        break;
+    case Track::TrackMode::Curve:
+        currentStep = trackEngine.as<CurveTrackEngine>().currentStep();
+        break;
+    case Track::TrackMode::MidiCv:
+    case Track::TrackMode::Last:
+        break;
+    }
+    return currentStep >= 0 ? currentStep % 8 : 0;
 }
 
 void LaunchpadController::recvMidi(uint8_t cable, const MidiMessage &message) {
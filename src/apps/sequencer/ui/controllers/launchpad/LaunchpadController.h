@@ -84,6 +84,8 @@ private:
 
     void setMode(Mode mode);
 
+    int playheadColumn() const;
+
     // Global handlers
     void globalDraw();
     bool globalButton(const Button &button, ButtonAction action);
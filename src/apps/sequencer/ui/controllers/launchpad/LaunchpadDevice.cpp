@@ -49,36 +49,93 @@ void LaunchpadDevice::recvMidi(uint8_t cable, const MidiMessage &message) {
     }
 }
 
-void LaunchpadDevice::syncLeds() {
-    // grid
-    for (int row = 0; row < Rows; ++row) {
-        for (int col = 0; col < Cols; ++col) {
-            int index = row * Cols + col;
-            if (_deviceLedState[index] != _ledState[index]) {
-                if (sendMidi(Cable, MidiMessage::makeNoteOn(0, row * 16 + col, _ledState[index]))) {
-                    _deviceLedState[index] = _ledState[index];
-                }
-            }
-        }
-    }
+int LaunchpadDevice::sendLeds(int maxMessages, int firstCol) {
+    int messages = 0;
 
-    // scene
-    for (int col = 0; col < Cols; ++col) {
-        int index = SceneRow * Cols + col;
+    for (int i = 0; i < ButtonCount && messages < maxMessages; ++i) {
+        int index = syncIndex(i, firstCol);
         if (_deviceLedState[index] != _ledState[index]) {
-            if (sendMidi(Cable, MidiMessage::makeNoteOn(0, col * 16 + 8, _ledState[index]))) {
-                _deviceLedState[index] = _ledState[index];
+            if (!sendLed(index / Cols, index % Cols, _ledState[index])) {
+                break;
             }
+            _deviceLedState[index] = _ledState[index];
+            ++messages;
         }
     }
 
-    // function
-    for (int col = 0; col < Cols; ++col) {
-        int index = FunctionRow * Cols + col;
-        if (_deviceLedState[index] != _ledState[index]) {
-            if (sendMidi(Cable, MidiMessage::makeControlChange(0, 104 + col, _ledState[index]))) {
-                _deviceLedState[index] = _ledState[index];
+    return messages;
+}
+
+bool LaunchpadDevice::sendLed(int row, int col, uint8_t state) {
+    if (row < Rows) {
+        return sendMidi(Cable, MidiMessage::makeNoteOn(0, row * 16 + col, state));
+    } else if (row == SceneRow) {
+        return sendMidi(Cable, MidiMessage::makeNoteOn(0, col * 16 + 8, state));
+    } else {
+        return sendMidi(Cable, MidiMessage::makeControlChange(0, 104 + col, state));
+    }
+}
+
+int LaunchpadDevice::syncLedsSysex(uint8_t cable, const SysexLedFormat &format, int maxMessages, int firstCol) {
+    std::array<uint8_t, SysexLedPayloadLength> payload;
+    std::array<uint8_t, SysexLedPayloadLength / 2> indices;
+
+    const size_t headerLength = format.header.size();
+    std::copy(format.header.begin(), format.header.end(), payload.begin());
+    size_t length = headerLength;
+    size_t count = 0;
+
+    int messages = 0;
+
+    for (int i = 0; i < ButtonCount; ++i) {
+        int index = syncIndex(i, firstCol);
+        if (_deviceLedState[index] == _ledState[index]) {
+            continue;
+        }
+
+        if (length + 2 > payload.size()) {
+            if (messages >= maxMessages || !sendLedsSysex(cable, payload.data(), length, indices.data(), count)) {
+                return messages;
             }
+            ++messages;
+            length = headerLength;
+            count = 0;
+        }
+
+        int row = index / Cols;
+        int col = index % Cols;
+        uint8_t led;
+        if (row < Rows) {
+            led = 11 + 10 * (7 - row) + col;
+        } else if (row == SceneRow) {
+            led = 11 + 10 * (7 - col) + 8;
+        } else {
+            led = format.functionLedBase + col;
         }
+
+        payload[length++] = led;
+        payload[length++] = _ledState[index];
+        indices[count++] = index;
     }
+
+    if (count > 0 && messages < maxMessages && sendLedsSysex(cable, payload.data(), length, indices.data(), count)) {
+        ++messages;
+    }
+
+    return messages;
+}
+
+bool LaunchpadDevice::sendLedsSysex(uint8_t cable, const uint8_t *payload, size_t length, const uint8_t *indices, size_t count) {
+    // payload allocation fails while the payload pool is used up by queued messages,
+    // leds stay out of sync and are sent with the next update
+    auto message = MidiMessage::makeSystemExclusive(payload, length);
+    if (!message.hasPayload() || !sendMidi(cable, message)) {
+        return false;
+    }
+
+    for (size_t i = 0; i < count; ++i) {
+        _deviceLedState[indices[i]] = _ledState[indices[i]];
+    }
+
+    return true;
 }
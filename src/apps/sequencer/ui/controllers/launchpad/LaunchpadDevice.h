@@ -72,11 +72,43 @@ public:
         _ledState[row * Cols + col] = state;
     }
 
-    virtual void syncLeds();
+    // sends changed leds using at most maxMessages messages and returns the number of messages sent,
+    // grid leds are sent column by column starting with column firstCol
+    int syncLeds(int maxMessages = ButtonCount, int firstCol = 0) {
+        return sendLeds(maxMessages, firstCol);
+    }
+
+    // returns true if the device shows the current led state
+    bool ledsSynced() const {
+        return _deviceLedState == _ledState;
+    }
 
 protected:
     static constexpr uint8_t Cable = 0;
 
+    virtual int sendLeds(int maxMessages, int firstCol);
+    virtual bool sendLed(int row, int col, uint8_t state);
+
+    // index of the i-th led to send when starting with grid column firstCol
+    static int syncIndex(int i, int firstCol) {
+        if (i < Rows * Cols) {
+            return (i % Rows) * Cols + (firstCol + i / Rows) % Cols;
+        }
+        return i;
+    }
+
+    // largest "set leds" system exclusive payload, the complete message fits into a single usb packet
+    static constexpr size_t SysexLedPayloadLength = 42;
+
+    // format of the "set leds" system exclusive message (Mk2 and Pro)
+    struct SysexLedFormat {
+        std::array<uint8_t, 6> header;  // manufacturer id, device id and command
+        uint8_t functionLedBase;        // led number of the first led in the function row
+    };
+
+    // sends changed leds in batches using "set leds" system exclusive messages
+    int syncLedsSysex(uint8_t cable, const SysexLedFormat &format, int maxMessages, int firstCol);
+
     bool sendMidi(uint8_t cable, const MidiMessage &message) {
         if (_sendMidiHandler) {
             return _sendMidiHandler(cable, message);
@@ -84,6 +116,8 @@ protected:
         return false;
     }
 
+    bool sendLedsSysex(uint8_t cable, const uint8_t *payload, size_t length, const uint8_t *indices, size_t count);
+
     void setButtonState(int row, int col, bool state) {
         _buttonState[row * Cols + col] = state;
         if (_buttonHandler) {
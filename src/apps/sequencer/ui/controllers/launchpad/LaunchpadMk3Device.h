@@ -21,7 +21,8 @@ public:
         _ledState[row * Cols + col] = mapColor(red, green, style);;
     }
 
-    void syncLeds() override;
+protected:
+    bool sendLed(int row, int col, uint8_t state) override;
 
 private:
     static constexpr uint8_t Cable = 1;
@@ -19,7 +19,8 @@ public:
         _ledState[row * Cols + col] = mapColor(red, green, style);;
     }
 
-    void syncLeds() override;
+protected:
+    int sendLeds(int maxMessages, int firstCol) override;
 
 private:
     static constexpr uint8_t Cable = 0;
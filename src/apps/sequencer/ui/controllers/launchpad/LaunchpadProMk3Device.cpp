@@ -56,36 +56,12 @@ void LaunchpadProMk3Device::recvMidi(uint8_t cable, const MidiMessage &message)
     }
 }
 
-void LaunchpadProMk3Device::syncLeds() {
-    // grid
-    for (int row = 0; row < Rows; ++row) {
-        for (int col = 0; col < Cols; ++col) {
-            int index = row * Cols + col;
-            if (_deviceLedState[index] != _ledState[index]) {
-                if (sendMidi(Cable, MidiMessage::makeNoteOn(0, 11 + 10 * (7 - row) + col, _ledState[index]))) {
-                    _deviceLedState[index] = _ledState[index];
-                }
-            }
-        }
-    }
-
-    // scene
-    for (int col = 0; col < Cols; ++col) {
-        int index = SceneRow * Cols + col;
-        if (_deviceLedState[index] != _ledState[index]) {
-            if (sendMidi(Cable, MidiMessage::makeControlChange(0, 11 + 10 * (7 - col) + 8, _ledState[index]))) {
-                _deviceLedState[index] = _ledState[index];
-            }
-        }
-    }
-
-    // function
-    for (int col = 0; col < Cols; ++col) {
-        int index = FunctionRow * Cols + col;
-        if (_deviceLedState[index] != _ledState[index]) {
-            if (sendMidi(Cable, MidiMessage::makeControlChange(0, 91 + col, _ledState[index]))) {
-                _deviceLedState[index] = _ledState[index];
-            }
-        }
+bool LaunchpadProMk3Device::sendLed(int row, int col, uint8_t state) {
+    if (row < Rows) {
+        return sendMidi(Cable, MidiMessage::makeNoteOn(0, 11 + 10 * (7 - row) + col, state));
+    } else if (row == SceneRow) {
+        return sendMidi(Cable, MidiMessage::makeControlChange(0, 11 + 10 * (7 - col) + 8, state));
+    } else {
+        return sendMidi(Cable, MidiMessage::makeControlChange(0, 91 + col, state));
     }
 }
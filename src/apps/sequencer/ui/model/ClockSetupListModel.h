@@ -36,6 +36,8 @@ private:
     enum Item {
         Mode,
         ShiftMode,
+        SlaveSync,
+        SlaveResponse,
         ClockInputDivisor,
         ClockInputMode,
         ClockOutputDivisor,
@@ -53,6 +55,8 @@ private:
         switch (item) {
         case Mode:              return "Mode";
         case ShiftMode:         return "Shift Mode";
+        case SlaveSync:         return "Slave Sync";
+        case SlaveResponse:     return "Slave Response";
         case ClockInputDivisor: return "Input Divisor";
         case ClockInputMode:    return "Input Mode";
         case ClockOutputDivisor:return "Output Divisor";
@@ -80,6 +84,12 @@ private:
         case ShiftMode:
             _clockSetup.printShiftMode(str);
             break;
+        case SlaveSync:
+            _clockSetup.printSlaveSync(str);
+            break;
+        case SlaveResponse:
+            _clockSetup.printSlaveResponse(str);
+            break;
         case ClockInputDivisor:
             _clockSetup.printClockInputDivisor(str);
             break;
@@ -123,6 +133,12 @@ private:
         case ShiftMode:
             _clockSetup.editShiftMode(value, shift);
             break;
+        case SlaveSync:
+            _clockSetup.editSlaveSync(value, shift);
+            break;
+        case SlaveResponse:
+            _clockSetup.editSlaveResponse(value, shift);
+            break;
         case ClockInputDivisor:
             _clockSetup.editClockInputDivisor(value, shift);
             break;
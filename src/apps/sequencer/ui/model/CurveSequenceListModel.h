@@ -14,6 +14,7 @@ public:
         RunMode,
         Divisor,
         ResetMeasure,
+        Seed,
         Range,
         Last
     };
@@ -84,6 +85,7 @@ private:
         case RunMode:           return "Run Mode";
         case Divisor:           return "Divisor";
         case ResetMeasure:      return "Reset Measure";
+        case Seed:              return "Seed";
         case Range:             return "Range";
         case Last:              break;
         }
@@ -111,6 +113,9 @@ private:
         case ResetMeasure:
             _sequence->printResetMeasure(str);
             break;
+        case Seed:
+            _sequence->printSeed(str);
+            break;
         case Range:
             _sequence->printRange(str);
             break;
@@ -136,6 +141,9 @@ private:
         case ResetMeasure:
             _sequence->editResetMeasure(value, shift);
             break;
+        case Seed:
+            _sequence->editSeed(value, shift);
+            break;
         case Range:
             _sequence->editRange(value, shift);
             break;
@@ -156,6 +164,7 @@ private:
             return 16;
         case Range:
             return int(Types::VoltageRange::Last);
+        case Seed:
         case Last:
             break;
         }
@@ -176,6 +185,7 @@ private:
             return _sequence->resetMeasure();
         case Range:
             return int(_sequence->range());
+        case Seed:
         case Last:
             break;
         }
@@ -196,6 +206,7 @@ private:
             return _sequence->setResetMeasure(index);
         case Range:
             return _sequence->setRange(Types::VoltageRange(index));
+        case Seed:
         case Last:
             break;
         }
@@ -57,6 +57,7 @@ private:
         PlayMode,
         FillMode,
         MuteMode,
+        OutputMode,
         SlideTime,
         Offset,
         Rotate,
@@ -71,6 +72,7 @@ private:
         case PlayMode:              return "Play Mode";
         case FillMode:              return "Fill Mode";
         case MuteMode:              return "Mute Mode";
+        case OutputMode:            return "Output Mode";
         case SlideTime:             return "Slide Time";
         case Offset:                return "Offset";
         case Rotate:                return "Rotate";
@@ -99,6 +101,9 @@ private:
         case MuteMode:
             _track->printMuteMode(str);
             break;
+        case OutputMode:
+            _track->printOutputMode(str);
+            break;
         case SlideTime:
             _track->printSlideTime(str);
             break;
@@ -132,6 +137,9 @@ private:
         case MuteMode:
             _track->editMuteMode(value, shift);
             break;
+        case OutputMode:
+            _track->editOutputMode(value, shift);
+            break;
         case SlideTime:
             _track->editSlideTime(value, shift);
             break;
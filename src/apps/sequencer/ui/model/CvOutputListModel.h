@@ -15,7 +15,7 @@ public:
     {}
 
     virtual int rows() const override {
-        return CONFIG_TRACK_COUNT;
+        return CONFIG_CHANNEL_COUNT;
     }
 
     virtual int columns() const override {
@@ -15,6 +15,7 @@ public:
         RunMode,
         Divisor,
         ResetMeasure,
+        Seed,
         Scale,
         RootNote,
         Last
@@ -90,6 +91,7 @@ private:
         case RunMode:           return "Run Mode";
         case Divisor:           return "Divisor";
         case ResetMeasure:      return "Reset Measure";
+        case Seed:              return "Seed";
         case Scale:             return "Scale";
         case RootNote:          return "Root Note";
         case Last:              break;
@@ -118,6 +120,9 @@ private:
         case ResetMeasure:
             _sequence->printResetMeasure(str);
             break;
+        case Seed:
+            _sequence->printSeed(str);
+            break;
         case Scale:
             _sequence->printScale(str);
             break;
@@ -146,6 +151,9 @@ private:
         case ResetMeasure:
             _sequence->editResetMeasure(value, shift);
             break;
+        case Seed:
+            _sequence->editSeed(value, shift);
+            break;
         case Scale:
             _sequence->editScale(value, shift);
             break;
@@ -171,6 +179,7 @@ private:
             return Scale::Count + 1;
         case RootNote:
             return 12 + 1;
+        case Seed:
         case Last:
             break;
         }
@@ -193,6 +202,7 @@ private:
             return _sequence->indexedScale();
         case RootNote:
             return _sequence->indexedRootNote();
+        case Seed:
         case Last:
             break;
         }
@@ -215,6 +225,7 @@ private:
             return _sequence->setIndexedScale(index);
         case RootNote:
             return _sequence->setIndexedRootNote(index);
+        case Seed:
         case Last:
             break;
         }
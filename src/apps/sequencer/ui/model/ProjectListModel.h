@@ -60,6 +60,7 @@ private:
         MidiPgmChange,
         CvGateInput,
         CurveCvInput,
+        RandomSeed,
         Last
     };
 
@@ -78,6 +79,7 @@ private:
         case MidiPgmChange:     return "MIDI Pgm Chng";
         case CvGateInput:       return "CV/Gate Input";
         case CurveCvInput:      return "Curve CV Input";
+        case RandomSeed:        return "Random Seed";
         case Last:              break;
         }
         return nullptr;
@@ -128,6 +130,9 @@ private:
         case CurveCvInput:
             _project.printCurveCvInput(str);
             break;
+        case RandomSeed:
+            _project.printRandomSeed(str);
+            break;
         case Last:
             break;
         }
@@ -173,6 +178,9 @@ private:
         case CurveCvInput:
             _project.editCurveCvInput(value, shift);
             break;
+        case RandomSeed:
+            _project.editRandomSeed(value, shift);
+            break;
         case Last:
             break;
         }
@@ -225,4 +225,14 @@ void MonitorPage::drawStats(Canvas &canvas) {
         drawValue(2, "USBMIDI OVF:", str);
     }
 
+    {
+        FixedStringBuilder<16> str("%d", stats.usbMidiTxOverflow);
+        drawValue(3, "USBMIDI TX OVF:", str);
+    }
+
+    {
+        FixedStringBuilder<16> str("%d", stats.midiReceiveDropped);
+        drawValue(4, "UI MIDI DROP:", str);
+    }
+
 }
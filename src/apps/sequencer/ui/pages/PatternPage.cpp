@@ -74,12 +74,15 @@ void PatternPage::draw(Canvas &canvas) {
     canvas.setFont(Font::Tiny);
     canvas.setBlendMode(BlendMode::Set);
 
-    for (int trackIndex = 0; trackIndex < CONFIG_TRACK_COUNT; ++trackIndex) {
+    int trackOffset = _project.trackBankOffset();
+
+    for (int bankIndex = 0; bankIndex < CONFIG_TRACK_BANK_SIZE; ++bankIndex) {
+        int trackIndex = trackOffset + bankIndex;
         const auto &trackEngine = _engine.trackEngine(trackIndex);
         const auto &trackState = playState.trackState(trackIndex);
-        bool trackSelected = pageKeyState()[MatrixMap::fromTrack(trackIndex)];
+        bool trackSelected = pageKeyState()[MatrixMap::fromTrack(bankIndex)];
 
-        int x = trackIndex * 32;
+        int x = bankIndex * 32;
         int y = 16;
 
         int w = 28;
@@ -139,6 +142,8 @@ void PatternPage::updateLeds(Leds &leds) {
         uint16_t selectedActivePatterns = 0;
         uint16_t selectedRequestedPatterns = 0;
 
+        int trackOffset = _project.trackBankOffset();
+
         for (int trackIndex = 0; trackIndex < CONFIG_TRACK_COUNT; ++trackIndex) {
             const auto &trackState = playState.trackState(trackIndex);
             bool hasPatternRequest = trackState.hasPatternRequest();
@@ -146,7 +151,8 @@ void PatternPage::updateLeds(Leds &leds) {
             int requestedPattern = trackState.requestedPattern();
             allActivePatterns |= (pattern < 16) ? (1<<pattern) : 0;
             allRequestedPatterns |= (hasPatternRequest && requestedPattern < 16) ? (1<<requestedPattern) : 0;
-            if (pageKeyState()[MatrixMap::fromTrack(trackIndex)]) {
+            int bankIndex = trackIndex - trackOffset;
+            if (bankIndex >= 0 && bankIndex < CONFIG_TRACK_BANK_SIZE && pageKeyState()[MatrixMap::fromTrack(bankIndex)]) {
                 selectedActivePatterns |= (pattern < 16) ? (1<<pattern) : 0;
                 selectedRequestedPatterns |= (hasPatternRequest && requestedPattern < 16) ? (1<<requestedPattern) : 0;
             }
@@ -282,9 +288,9 @@ void PatternPage::keyPress(KeyPressEvent &event) {
             else if (_patternChangeDefault==1) executeType = PlayState::Synced;
 
             bool globalChange = true;
-            for (int trackIndex = 0; trackIndex < CONFIG_TRACK_COUNT; ++trackIndex) {
-                if (pageKeyState()[MatrixMap::fromTrack(trackIndex)]) {
-                    playState.selectTrackPattern(trackIndex, pattern, executeType);
+            for (int bankIndex = 0; bankIndex < CONFIG_TRACK_BANK_SIZE; ++bankIndex) {
+                if (pageKeyState()[MatrixMap::fromTrack(bankIndex)]) {
+                    playState.selectTrackPattern(_project.trackBankOffset() + bankIndex, pattern, executeType);
                     globalChange = false;
                 }
             }
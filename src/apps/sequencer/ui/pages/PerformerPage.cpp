@@ -50,11 +50,14 @@ void PerformerPage::draw(Canvas &canvas) {
     canvas.setFont(Font::Tiny);
     canvas.setBlendMode(BlendMode::Set);
 
-    for (int trackIndex = 0; trackIndex < CONFIG_TRACK_COUNT; ++trackIndex) {
+    int trackOffset = _project.trackBankOffset();
+
+    for (int bankIndex = 0; bankIndex < CONFIG_TRACK_BANK_SIZE; ++bankIndex) {
+        int trackIndex = trackOffset + bankIndex;
         const auto &trackEngine = _engine.trackEngine(trackIndex);
         const auto &trackState = playState.trackState(trackIndex);
 
-        int x = trackIndex * 32;
+        int x = bankIndex * 32;
         int y = 16;
 
         int w = 16;
@@ -85,7 +88,7 @@ void PerformerPage::draw(Canvas &canvas) {
         SequencePainter::drawSequenceProgress(canvas, x, y + h + 2, w, 2, trackEngine.sequenceProgress());
 
         // draw fill & fill amount amount
-        bool pressed = pageKeyState()[MatrixMap::fromStep(trackIndex)];
+        bool pressed = pageKeyState()[MatrixMap::fromStep(bankIndex)];
         canvas.setColor(pressed ? Color::Bright : Color::Low);
         canvas.fillRect(x, y + h + 6, w, 4);
         canvas.setColor(pressed ? Color::Bright : Color::Medium);
@@ -101,12 +104,14 @@ void PerformerPage::draw(Canvas &canvas) {
 void PerformerPage::updateLeds(Leds &leds) {
     const auto &playState = _project.playState();
 
-    LedPainter::drawTrackGates(leds, _engine, _project.playState());
+    int trackOffset = _project.trackBankOffset();
+
+    LedPainter::drawTrackGates(leds, _engine, _project.playState(), trackOffset);
 
     uint8_t activeFills = 0;
-    for (int trackIndex = 0; trackIndex < CONFIG_TRACK_COUNT; ++trackIndex) {
-        const auto &trackState = playState.trackState(trackIndex);
-        activeFills |= trackState.fill() ? (1<<trackIndex) : 0;
+    for (int bankIndex = 0; bankIndex < CONFIG_TRACK_BANK_SIZE; ++bankIndex) {
+        const auto &trackState = playState.trackState(trackOffset + bankIndex);
+        activeFills |= trackState.fill() ? (1<<bankIndex) : 0;
     }
 
     LedPainter::drawMutes(leds, 0, 0);
@@ -224,9 +229,9 @@ void PerformerPage::keyPress(KeyPressEvent &event) {
 
     if (key.isTrackSelect()) {
         if (key.shiftModifier()) {
-            playState.toggleSoloTrack(key.track(), executeType);
+            playState.toggleSoloTrack(_project.trackBankOffset() + key.track(), executeType);
         } else {
-            playState.toggleMuteTrack(key.track(), executeType);
+            playState.toggleMuteTrack(_project.trackBankOffset() + key.track(), executeType);
         }
         event.consume();
     }
@@ -237,9 +242,9 @@ void PerformerPage::encoder(EncoderEvent &event) {
     if (!isKeySelected()) {
         _project.setTempo(_project.tempo()+event.value());
     } else {    
-        for (int trackIndex = 0; trackIndex < 8; ++trackIndex) {
-            if (pageKeyState()[MatrixMap::fromStep(trackIndex)]) {
-                _project.playState().trackState(trackIndex).editFillAmount(event.value(), false);
+        for (int bankIndex = 0; bankIndex < CONFIG_TRACK_BANK_SIZE; ++bankIndex) {
+            if (pageKeyState()[MatrixMap::fromStep(bankIndex)]) {
+                _project.playState().trackState(_project.trackBankOffset() + bankIndex).editFillAmount(event.value(), false);
             }
         }
     }
@@ -250,8 +255,11 @@ void PerformerPage::updateFills() {
     bool fillPressed = pageKeyState()[MatrixMap::fromFunction(int(Function::Fill))];
     bool holdPressed = pageKeyState()[Key::Shift];
 
+    int trackOffset = _project.trackBankOffset();
+
     for (int trackIndex = 0; trackIndex < CONFIG_TRACK_COUNT; ++trackIndex) {
-        bool trackFill = pageKeyState()[MatrixMap::fromStep(8 + trackIndex)];
+        int bankIndex = trackIndex - trackOffset;
+        bool trackFill = bankIndex >= 0 && bankIndex < CONFIG_TRACK_BANK_SIZE && pageKeyState()[MatrixMap::fromStep(8 + bankIndex)];
         playState.fillTrack(trackIndex, trackFill || fillPressed, holdPressed);
     }
 }
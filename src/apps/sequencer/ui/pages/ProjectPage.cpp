@@ -142,7 +142,12 @@ void ProjectPage::loadProject() {
         if (result) {
             _manager.pages().confirmation.show("ARE YOU SURE?", [this, slot] (bool result) {
                 if (result) {
-                    loadProjectFromSlot(slot);
+                    // switch projects without interrupting playback if possible
+                    if (_engine.state().running() && FileManager::projectCueAvailable()) {
+                        cueProjectFromSlot(slot);
+                    } else {
+                        loadProjectFromSlot(slot);
+                    }
                 }
             });
         }
@@ -179,7 +184,11 @@ void ProjectPage::initRoute() {
 }
 
 void ProjectPage::saveProjectToSlot(int slot) {
-    _engine.suspend();
+    // capture engine modified state instead of suspending the engine, so playback continues while saving
+    _engine.lock();
+    _project.createSaveState();
+    _engine.unlock();
+
     _manager.pages().busy.show("SAVING PROJECT ...");
 
     FileManager::task([this, slot] () {
@@ -192,11 +201,12 @@ void ProjectPage::saveProjectToSlot(int slot) {
         }
         // TODO lock ui mutex
         _manager.pages().busy.close();
-        _engine.resume();
+        _project.releaseSaveState();
     });
 }
 
 void ProjectPage::loadProjectFromSlot(int slot) {
+    FileManager::clearProjectCue();
     _engine.suspend();
     _manager.pages().busy.show("LOADING PROJECT ...");
 
@@ -216,3 +226,21 @@ void ProjectPage::loadProjectFromSlot(int slot) {
         _engine.resume();
     });
 }
+
+void ProjectPage::cueProjectFromSlot(int slot) {
+    _manager.pages().busy.show("CUEING PROJECT ...");
+
+    FileManager::task([slot] () {
+        return FileManager::cueProject(slot);
+    }, [this] (fs::Error result) {
+        if (result == fs::OK) {
+            showMessage("PROJECT CUED");
+        } else if (result == fs::INVALID_CHECKSUM) {
+            showMessage("INVALID PROJECT FILE");
+        } else {
+            showMessage(FixedStringBuilder<32>("FAILED (%s)", fs::errorToString(result)));
+        }
+        // TODO lock ui mutex
+        _manager.pages().busy.close();
+    });
+}
@@ -30,6 +30,7 @@ private:
 
     void saveProjectToSlot(int slot);
     void loadProjectFromSlot(int slot);
+    void cueProjectFromSlot(int slot);
 
     ProjectListModel _listModel;
 };
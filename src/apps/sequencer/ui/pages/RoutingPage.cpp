@@ -52,7 +52,7 @@ void RoutingPage::keyPress(KeyPressEvent &event) {
     const auto &key = event.key();
 
     if (edit() && selectedRow() == int(RouteListModel::Item::Tracks) && key.isTrack()) {
-        _editRoute.toggleTrack(key.track());
+        _editRoute.toggleTrack(_project.trackBankOffset() + key.track());
         event.consume();
         return;
     }
@@ -89,6 +89,7 @@ void RoutingPage::keyPress(KeyPressEvent &event) {
                 showMessage(FixedStringBuilder<64>("ROUTE SETTINGS CONFLICT WITH ROUTE %d", conflict + 1));
             } else {
                 *_route = _editRoute;
+                _project.routing().setDirty();
                 setEdit(false);
                 showMessage("ROUTE CHANGED");
             }
@@ -128,11 +129,14 @@ void RoutingPage::drawCell(Canvas &canvas, int row, int column, int x, int y, in
         canvas.setBlendMode(BlendMode::Set);
         canvas.setColor(edit() && row == selectedRow() ? Color::Bright : Color::Medium);
 
-        uint8_t tracks = _editRoute.tracks();
+        // shrink track boxes to fit all tracks
+        int spacing = std::min(10, (Width - x) / CONFIG_TRACK_COUNT);
+        int size = spacing - 2;
+        Types::TrackBits tracks = _editRoute.tracks();
         for (int i = 0; i < CONFIG_TRACK_COUNT; ++i) {
-            canvas.drawRect(x + i * 10, y + 1, 8, 8);
-            if (tracks & (1 << i)) {
-                canvas.fillRect(x + 2 + i * 10, y + 3, 4, 4);
+            canvas.drawRect(x + i * spacing, y + 1, size, size);
+            if (tracks & (Types::TrackBits(1) << i)) {
+                canvas.fillRect(x + size / 4 + i * spacing, y + 1 + size / 4, size / 2, size / 2);
             }
         }
     } else {
@@ -53,13 +53,13 @@ void SongPage::draw(Canvas &canvas) {
     const char *functionNames[] = { "CHAIN", isShift ? "INSERT" : "ADD", "REMOVE", "DUPL", isPlaying ? "STOP" : "PLAY" };
 
     uint8_t selectedTracks = pressedTrackKeys();
+    int trackOffset = _project.trackBankOffset();
 
     WindowPainter::clear(canvas);
     WindowPainter::drawHeader(canvas, _model, _engine, "SONG");
     WindowPainter::drawFooter(canvas, functionNames, pageKeyState());
 
     const int colWidth[] = { 16, 16, 20, 20, 20, 20, 20, 20, 20, 20 };
-    const char *colHeader[] = { "#", "N", "T1", "T2", "T3", "T4", "T5", "T6", "T7", "T8" };
     const int rowHeight = 8;
     const int tableOriginX = 60;
     const int tableOriginY = 11;
@@ -81,8 +81,16 @@ void SongPage::draw(Canvas &canvas) {
     {
         int x = tableOriginX;
         for (int colIndex = 0; colIndex < 10; ++colIndex) {
+            FixedStringBuilder<8> str;
+            if (colIndex == 0) {
+                str("#");
+            } else if (colIndex == 1) {
+                str("N");
+            } else {
+                str("T%d", trackOffset + colIndex - 1);
+            }
             canvas.setColor(isHighlighted(colIndex) ? Color::Bright : Color::Medium);
-            canvas.drawTextCentered(x, y, colWidth[colIndex], rowHeight, colHeader[colIndex]);
+            canvas.drawTextCentered(x, y, colWidth[colIndex], rowHeight, str);
             x += colWidth[colIndex];
         }
         y += rowHeight;
@@ -116,7 +124,7 @@ void SongPage::draw(Canvas &canvas) {
                 }
             } else {
                 if (slotActive) {
-                    int trackIndex = colIndex - 2;
+                    int trackIndex = trackOffset + colIndex - 2;
                     if (slot.mute(trackIndex)) {
                         str("M");
                     } else {
@@ -166,8 +174,9 @@ void SongPage::draw(Canvas &canvas) {
 void SongPage::updateLeds(Leds &leds) {
     bool isShift = globalKeyState()[Key::Shift];
     uint8_t selectedTracks = pressedTrackKeys();
+    int trackOffset = _project.trackBankOffset();
 
-    LedPainter::drawTrackGates(leds, _engine, _project.playState());
+    LedPainter::drawTrackGates(leds, _engine, _project.playState(), trackOffset);
 
     if (_selectedSlot >= 0) {
         const auto &slot = _project.song().slot(_selectedSlot);
@@ -178,9 +187,9 @@ void SongPage::updateLeds(Leds &leds) {
             }
         } else {
             uint16_t usedPatterns = 0;
-            for (int trackIndex = 0; trackIndex < 8; ++trackIndex) {
-                if (selectedTracks == 0 || selectedTracks & (1 << trackIndex)) {
-                    usedPatterns |= (1 << slot.pattern(trackIndex));
+            for (int bankIndex = 0; bankIndex < CONFIG_TRACK_BANK_SIZE; ++bankIndex) {
+                if (selectedTracks == 0 || selectedTracks & (1 << bankIndex)) {
+                    usedPatterns |= (1 << slot.pattern(trackOffset + bankIndex));
                 }
             }
             LedPainter::drawSongSlot(leds, usedPatterns);
@@ -267,9 +276,9 @@ void SongPage::keyPress(KeyPressEvent &event) {
 
     if (key.isEncoder()) {
         if (selectedTracks) {
-            for (int trackIndex = 0; trackIndex < CONFIG_TRACK_COUNT; ++trackIndex) {
-                if (selectedTracks & (1 << trackIndex)) {
-                    _project.song().toggleMute(_selectedSlot, trackIndex);
+            for (int bankIndex = 0; bankIndex < CONFIG_TRACK_BANK_SIZE; ++bankIndex) {
+                if (selectedTracks & (1 << bankIndex)) {
+                    _project.song().toggleMute(_selectedSlot, _project.trackBankOffset() + bankIndex);
                 }
             }
         } else {
@@ -288,9 +297,9 @@ void SongPage::keyPress(KeyPressEvent &event) {
             switch (_mode) {
             case Mode::Idle: {
                 bool globalChange = true;
-                for (int trackIndex = 0; trackIndex < 8; ++trackIndex) {
-                    if (globalKeyState()[MatrixMap::fromTrack(trackIndex)]) {
-                        song.setPattern(_selectedSlot, trackIndex, pattern);
+                for (int bankIndex = 0; bankIndex < CONFIG_TRACK_BANK_SIZE; ++bankIndex) {
+                    if (globalKeyState()[MatrixMap::fromTrack(bankIndex)]) {
+                        song.setPattern(_selectedSlot, _project.trackBankOffset() + bankIndex, pattern);
                         globalChange = false;
                     }
                 }
@@ -331,9 +340,9 @@ void SongPage::encoder(EncoderEvent &event) {
     if (isShift) {
         _project.song().editRepeats(_selectedSlot, event.value());
     } else if (selectedTracks) {
-        for (int trackIndex = 0; trackIndex < CONFIG_TRACK_COUNT; ++trackIndex) {
-            if (selectedTracks & (1 << trackIndex)) {
-                _project.song().editPattern(_selectedSlot, trackIndex, event.value());
+        for (int bankIndex = 0; bankIndex < CONFIG_TRACK_BANK_SIZE; ++bankIndex) {
+            if (selectedTracks & (1 << bankIndex)) {
+                _project.song().editPattern(_selectedSlot, _project.trackBankOffset() + bankIndex, event.value());
             }
         }
     } else {
@@ -369,9 +378,9 @@ void SongPage::scrollTo(int row) {
 
 uint8_t SongPage::pressedTrackKeys() const {
     uint8_t tracks = 0;
-    for (int trackIndex = 0; trackIndex < CONFIG_TRACK_COUNT; ++trackIndex) {
-        if (globalKeyState()[MatrixMap::fromTrack(trackIndex)]) {
-            tracks |= (1 << trackIndex);
+    for (int bankIndex = 0; bankIndex < CONFIG_TRACK_BANK_SIZE; ++bankIndex) {
+        if (globalKeyState()[MatrixMap::fromTrack(bankIndex)]) {
+            tracks |= (1 << bankIndex);
         }
     }
     return tracks;
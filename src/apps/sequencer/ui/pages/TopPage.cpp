@@ -52,9 +52,10 @@ void TopPage::editRoute(Routing::Target target, int trackIndex) {
     routeIndex = routing.findEmptyRoute();
     if (routeIndex >= 0) {
         routing.route(routeIndex).clear();
+        routing.setDirty();
         Routing::Route initRoute;
         initRoute.setTarget(target);
-        initRoute.setTracks(1<<trackIndex);
+        initRoute.setTracks(Types::TrackBits(1) << trackIndex);
         setMode(Mode::Routing);
         _manager.pages().routing.showRoute(routeIndex, &initRoute);
     } else {
@@ -74,7 +75,7 @@ void TopPage::updateLeds(Leds &leds) {
     if (globalKeyState()[Key::Page] && !globalKeyState()[Key::Shift]) {
         LedPainter::drawSelectedPage(leds, _mode);
     } else {
-        LedPainter::drawTrackGatesAndSelectedTrack(leds, _engine, _project.playState(), _project.selectedTrackIndex());
+        LedPainter::drawTrackGatesAndSelectedTrack(leds, _engine, _project.playState(), _project.trackBankOffset(), _project.selectedTrackIndex());
     }
 }
 
@@ -91,7 +92,12 @@ void TopPage::keyPress(KeyPressEvent &event) {
     const auto &key = event.key();
 
     if (key.isTrackSelect()) {
-        _project.setSelectedTrackIndex(key.trackSelect());
+        int trackIndex = _project.trackBankOffset() + key.trackSelect();
+        // selecting the already selected track switches to the next track bank
+        if (CONFIG_TRACK_COUNT > CONFIG_TRACK_BANK_SIZE && trackIndex == _project.selectedTrackIndex()) {
+            trackIndex = (trackIndex + CONFIG_TRACK_BANK_SIZE) % CONFIG_TRACK_COUNT;
+        }
+        _project.setSelectedTrackIndex(trackIndex);
         event.consume();
     }
 
@@ -0,0 +1,209 @@
+#pragma once
+
+#include "File.h"
+
+#include "core/hash/FnvHash.h"
+
+#include <algorithm>
+
+#include <cstring>
+#include <cstddef>
+#include <cstdint>
+
+namespace fs {
+
+/**
+ * Block hasher.
+ * Computes a hash for each block of BlockSize bytes written to it. Used to capture the block hashes of a file
+ * while reading it, so that a following BlockFileWriter can skip unchanged blocks.
+ */
+class BlockHasher {
+public:
+    static constexpr size_t BlockSize = 512;
+
+    BlockHasher(uint32_t *blockHashes, size_t maxBlocks) :
+        _blockHashes(blockHashes),
+        _maxBlocks(maxBlocks)
+    {}
+
+    // number of blocks hashed so far (including a last partial block)
+    size_t blockCount() const {
+        return std::min(_block + (_pos > 0 ? 1 : 0), _maxBlocks);
+    }
+
+    void write(const void *data, size_t len) {
+        const uint8_t *src = static_cast<const uint8_t *>(data);
+        while (len > 0) {
+            size_t chunk = std::min(len, BlockSize - _pos);
+            _hash(src, chunk);
+            _pos += chunk;
+            src += chunk;
+            len -= chunk;
+            if (_pos == BlockSize) {
+                endBlock();
+            }
+        }
+    }
+
+    void finish() {
+        if (_pos > 0) {
+            endBlock();
+        }
+    }
+
+private:
+    void endBlock() {
+        if (_block < _maxBlocks) {
+            _blockHashes[_block] = _hash.result();
+        }
+        ++_block;
+        _hash = FnvHash();
+        _pos = 0;
+    }
+
+    uint32_t *_blockHashes;
+    size_t _maxBlocks;
+    size_t _block = 0;
+    size_t _pos = 0;
+    FnvHash _hash;
+};
+
+/**
+ * Block file writer.
+ * Rewrites an existing file in place, only writing blocks whose content has changed. The caller passes the block
+ * hashes of the current file content (as captured by a previous BlockFileWriter or BlockHasher), which are updated
+ * while writing. Blocks with a matching hash are read back and compared to not miss changes on hash collisions,
+ * reading a block is much cheaper than writing it. Blocks beyond maxBlocks as well as the last partial block are
+ * always written. The file is truncated if it shrinks. Keeps track of potential errors, which are returned when
+ * calling finish(). The block buffers are passed in by the caller to keep them off the stack.
+ */
+class BlockFileWriter {
+public:
+    static constexpr size_t BlockSize = 512;
+
+    // block being written and block read back for comparison
+    struct Buffers {
+        uint32_t write[BlockSize / 4];
+        uint32_t read[BlockSize / 4];
+    };
+
+    BlockFileWriter(const char *path, uint32_t *blockHashes, size_t maxBlocks, size_t knownBlocks, Buffers &buffers) :
+        _blockHashes(blockHashes),
+        _maxBlocks(maxBlocks),
+        _buffer(buffers.write),
+        _readBuffer(buffers.read)
+    {
+        _error = _file.open(path, File::Modify);
+        if (_error == OK) {
+            // never trust hashes of blocks that are not in the file
+            _knownBlocks = std::min(knownBlocks, (_file.size() + BlockSize - 1) / BlockSize);
+        }
+    }
+
+    ~BlockFileWriter() {
+        finish();
+    }
+
+    Error error() const { return _error; }
+
+    // number of valid block hashes after finish()
+    size_t blockCount() const {
+        return std::min(_block, _maxBlocks);
+    }
+
+    // number of bytes actually written to the file
+    size_t bytesWritten() const { return _bytesWritten; }
+
+    Error finish() {
+        if (!_finished) {
+            if (_error == OK && _pos > 0) {
+                writeBlock(true);
+            }
+            if (_error == OK && _file.size() > _length) {
+                _error = _file.seek(_length);
+                if (_error == OK) {
+                    _error = _file.truncate();
+                }
+            }
+            if (_error == OK) {
+                _error = _file.close();
+            } else {
+                _file.close();
+            }
+            _finished = true;
+        }
+        return _error;
+    }
+
+    Error write(const void *data, size_t len) {
+        const uint8_t *src = static_cast<const uint8_t *>(data);
+        uint8_t *buffer = reinterpret_cast<uint8_t *>(_buffer);
+        while (_error == OK && len > 0) {
+            size_t chunk = std::min(len, BlockSize - _pos);
+            memcpy(&buffer[_pos], src, chunk);
+            _pos += chunk;
+            src += chunk;
+            len -= chunk;
+            if (_pos == BlockSize) {
+                writeBlock(false);
+            }
+        }
+        return _error;
+    }
+
+private:
+    void writeBlock(bool last) {
+        FnvHash hash;
+        hash(_buffer, _pos);
+
+        bool known = _block < _knownBlocks && _block < _maxBlocks;
+        bool changed = last || !known || _blockHashes[_block] != hash.result() || !blockMatches();
+
+        if (_block < _maxBlocks) {
+            _blockHashes[_block] = hash.result();
+        }
+
+        if (_error == OK && changed) {
+            size_t offset = _block * BlockSize;
+            if (_file.tell() != offset) {
+                _error = _file.seek(offset);
+            }
+            if (_error == OK) {
+                _error = _file.writeAll(_buffer, _pos);
+                _bytesWritten += _pos;
+            }
+        }
+
+        _length += _pos;
+        ++_block;
+        _pos = 0;
+    }
+
+    // compare the buffered block with the block currently stored in the file
+    bool blockMatches() {
+        size_t offset = _block * BlockSize;
+        if (_file.tell() != offset) {
+            _error = _file.seek(offset);
+        }
+        size_t lenRead = 0;
+        if (_error == OK) {
+            _error = _file.read(_readBuffer, _pos, &lenRead);
+        }
+        return _error == OK && lenRead == _pos && memcmp(_readBuffer, _buffer, _pos) == 0;
+    }
+
+    File _file;
+    bool _finished = false;
+    Error _error;
+    uint32_t *_blockHashes;
+    size_t _maxBlocks;
+    size_t _knownBlocks = 0;
+    size_t _block = 0;
+    uint32_t *_buffer;
+    uint32_t *_readBuffer;
+    size_t _pos = 0;
+    size_t _length = 0;
+    size_t _bytesWritten = 0;
+};
+
+} // namespace fs
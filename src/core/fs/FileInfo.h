@@ -10,6 +10,9 @@ public:
 
     size_t size() const { return _info.fsize; }
 
+    // modification date and time in FAT format (date in the upper 16 bits)
+    uint32_t timestamp() const { return (uint32_t(_info.fdate) << 16) | _info.ftime; }
+
 private:
     FILINFO _info;
 
@@ -10,11 +10,13 @@ namespace fs {
 
 static Volume *g_volume;
 static SdCard *g_sdCard;
+static SectorCache *g_sectorCache;
 
 void setVolume(Volume *volume) {
     ASSERT(volume == nullptr || g_volume == nullptr, "only one volume allowed");
     g_volume = volume;
     g_sdCard = volume ? &volume->sdcard() : nullptr;
+    g_sectorCache = volume ? &volume->sectorCache() : nullptr;
 }
 
 Volume &volume() {
@@ -54,7 +56,12 @@ extern "C" {
 DSTATUS disk_initialize(BYTE pdrv) {
     ASSERT(pdrv == 0, "only one physical drive available");
     // DBG("disk_initialize(pdrv=%d)", pdrv);
-    return fs::g_sdCard->available() ? 0 : STA_NOINIT;
+    // cached sectors are dropped once the card is removed (see Volume::available()),
+    // otherwise the same card is still present and pending sectors are written back before remounting
+    if (!fs::g_volume->available()) {
+        return STA_NOINIT;
+    }
+    return fs::g_sectorCache->flush() ? 0 : STA_NOINIT;
 }
 
 DSTATUS disk_status(BYTE pdrv) {
@@ -72,13 +79,19 @@ DSTATUS disk_status(BYTE pdrv) {
 DRESULT disk_read(BYTE pdrv, BYTE *buf, DWORD sector, UINT count) {
     ASSERT(pdrv == 0, "only one physical drive available");
     // DBG("disk_read(pdrv=%d,sector=%d,count=%d)", pdrv, sector, count);
-    return fs::g_sdCard->read(buf, sector, count) ? RES_OK : RES_ERROR;
+    if (count == 1 && fs::g_volume->isWindowBuffer(buf)) {
+        return fs::g_sectorCache->readSector(buf, sector) ? RES_OK : RES_ERROR;
+    }
+    return fs::g_sectorCache->read(buf, sector, count) ? RES_OK : RES_ERROR;
 }
 
 DRESULT disk_write(BYTE pdrv, const BYTE *buf, DWORD sector, UINT count) {
     ASSERT(pdrv == 0, "only one physical drive available");
     // DBG("disk_write(pdrv=%d,sector=%d,count=%d)", pdrv, sector, count);
-    return fs::g_sdCard->write(buf, sector, count) ? RES_OK : RES_ERROR;
+    if (count == 1 && fs::g_volume->isWindowBuffer(buf)) {
+        return fs::g_sectorCache->writeSector(buf, sector) ? RES_OK : RES_ERROR;
+    }
+    return fs::g_sectorCache->write(buf, sector, count) ? RES_OK : RES_ERROR;
 }
 
 DRESULT disk_ioctl(BYTE pdrv, BYTE cmd, void *buf) {
@@ -86,6 +99,9 @@ DRESULT disk_ioctl(BYTE pdrv, BYTE cmd, void *buf) {
     // DBG("disk_ioctl(pdrv=%d,cmd=%d)", pdrv, cmd);
     switch (cmd) {
     case CTRL_SYNC:
+        if (!fs::g_sectorCache->flush()) {
+            return RES_ERROR;
+        }
         fs::g_sdCard->sync();
         return RES_OK;
     case GET_SECTOR_COUNT:
@@ -4,6 +4,7 @@
 #include "Volume.h"
 #include "File.h"
 #include "Directory.h"
+#include "FileInfo.h"
 
 #include <cstddef>
 #include <cstdint>
@@ -17,6 +18,7 @@ Error mkdir(const char *path);
 Error rmdir(const char *path);
 Error remove(const char *path);
 Error rename(const char *oldPath, const char *newPath);
+Error stat(const char *path, FileInfo &info);
 
 bool exists(const char *path);
 
@@ -0,0 +1,153 @@
+#include "SectorCache.h"
+
+#include <algorithm>
+
+#include <cstring>
+
+namespace fs {
+
+// largest number of sectors passed to the sd card driver at once
+static constexpr uint32_t MaxTransferCount = 128;
+
+SectorCache::SectorCache(SdCard &sdcard) :
+    _sdcard(sdcard)
+{
+    invalidate();
+}
+
+bool SectorCache::readSector(uint8_t *buf, uint32_t sector) {
+    int index = find(sector);
+    if (index >= 0) {
+        ++_hits;
+    } else {
+        ++_misses;
+        index = allocate(sector);
+        if (index < 0) {
+            return false;
+        }
+        if (!_sdcard.read(reinterpret_cast<uint8_t *>(_data[index]), sector, 1)) {
+            _entries[index].valid = false;
+            return false;
+        }
+    }
+    _entries[index].lastUse = ++_useCounter;
+    std::memcpy(buf, _data[index], SectorSize);
+    return true;
+}
+
+bool SectorCache::writeSector(const uint8_t *buf, uint32_t sector) {
+    int index = find(sector);
+    if (index < 0) {
+        index = allocate(sector);
+        if (index < 0) {
+            return false;
+        }
+    }
+    auto &entry = _entries[index];
+    entry.lastUse = ++_useCounter;
+    entry.dirty = true;
+    std::memcpy(_data[index], buf, SectorSize);
+    return true;
+}
+
+bool SectorCache::read(uint8_t *buf, uint32_t sector, uint32_t count) {
+    for (uint32_t offset = 0; offset < count; offset += MaxTransferCount) {
+        uint32_t chunk = std::min(count - offset, MaxTransferCount);
+        if (!_sdcard.read(buf + offset * SectorSize, sector + offset, chunk)) {
+            return false;
+        }
+    }
+
+    // cached sectors not yet written back are newer than the card contents
+    for (int index = 0; index < EntryCount; ++index) {
+        const auto &entry = _entries[index];
+        if (entry.valid && entry.dirty && entry.sector >= sector && entry.sector < sector + count) {
+            std::memcpy(buf + (entry.sector - sector) * SectorSize, _data[index], SectorSize);
+        }
+    }
+
+    return true;
+}
+
+bool SectorCache::write(const uint8_t *buf, uint32_t sector, uint32_t count) {
+    for (uint32_t offset = 0; offset < count; offset += MaxTransferCount) {
+        uint32_t chunk = std::min(count - offset, MaxTransferCount);
+        if (!_sdcard.write(buf + offset * SectorSize, sector + offset, chunk)) {
+            return false;
+        }
+    }
+
+    // keep cached sectors in sync with the card
+    for (int index = 0; index < EntryCount; ++index) {
+        auto &entry = _entries[index];
+        if (entry.valid && entry.sector >= sector && entry.sector < sector + count) {
+            std::memcpy(_data[index], buf + (entry.sector - sector) * SectorSize, SectorSize);
+            entry.dirty = false;
+        }
+    }
+
+    return true;
+}
+
+bool SectorCache::flush() {
+    bool success = true;
+    for (int index = 0; index < EntryCount; ++index) {
+        success &= writeBack(index);
+    }
+    return success;
+}
+
+void SectorCache::invalidate() {
+    for (auto &entry : _entries) {
+        entry.valid = false;
+        entry.dirty = false;
+    }
+}
+
+int SectorCache::find(uint32_t sector) const {
+    for (int index = 0; index < EntryCount; ++index) {
+        const auto &entry = _entries[index];
+        if (entry.valid && entry.sector == sector) {
+            return index;
+        }
+    }
+    return -1;
+}
+
+int SectorCache::allocate(uint32_t sector) {
+    // use a free entry or evict the least recently used one
+    int index = 0;
+    for (int i = 0; i < EntryCount; ++i) {
+        if (!_entries[i].valid) {
+            index = i;
+            break;
+        }
+        if (_useCounter - _entries[i].lastUse > _useCounter - _entries[index].lastUse) {
+            index = i;
+        }
+    }
+
+    if (!writeBack(index)) {
+        return -1;
+    }
+
+    auto &entry = _entries[index];
+    entry.sector = sector;
+    entry.lastUse = ++_useCounter;
+    entry.valid = true;
+    entry.dirty = false;
+    return index;
+}
+
+bool SectorCache::writeBack(int index) {
+    auto &entry = _entries[index];
+    if (entry.valid && entry.dirty) {
+        if (!_sdcard.write(reinterpret_cast<const uint8_t *>(_data[index]), entry.sector, 1)) {
+            return false;
+        }
+        entry.dirty = false;
+    }
+    return true;
+}
+
+} // namespace fs
@@ -0,0 +1,62 @@
+#pragma once
+
+#include "drivers/SdCard.h"
+
+#include <array>
+
+#include <cstddef>
+#include <cstdint>
+
+namespace fs {
+
+// Write-back LRU cache for FAT and directory sectors between the file system and the sd card.
+// FatFs reads and writes FAT and directory sectors one at a time through its window buffer and tends to revisit
+// the same few sectors while allocating clusters or updating directory entries. Cached writes are written to the
+// card on eviction or flush. File data bypasses the cache but is kept coherent with it.
+class SectorCache {
+public:
+    static constexpr int EntryCount = 4;
+    static constexpr size_t SectorSize = 512;
+
+    SectorCache(SdCard &sdcard);
+
+    // single sector access through the cache
+    bool readSector(uint8_t *buf, uint32_t sector);
+    bool writeSector(const uint8_t *buf, uint32_t sector);
+
+    // direct access to the card
+    bool read(uint8_t *buf, uint32_t sector, uint32_t count);
+    bool write(const uint8_t *buf, uint32_t sector, uint32_t count);
+
+    // writes back all dirty sectors
+    bool flush();
+
+    // drops all sectors without writing them back (i.e. after the card was removed)
+    void invalidate();
+
+    uint32_t hits() const { return _hits; }
+    uint32_t misses() const { return _misses; }
+
+private:
+    struct Entry {
+        uint32_t sector;
+        uint32_t lastUse;
+        bool valid;
+        bool dirty;
+    };
+
+    int find(uint32_t sector) const;
+    int allocate(uint32_t sector);
+    bool writeBack(int index);
+
+    SdCard &_sdcard;
+    std::array<Entry, EntryCount> _entries;
+    uint32_t _useCounter = 0;
+    uint32_t _hits = 0;
+    uint32_t _misses = 0;
+
+    // sectors are transferred by dma in 32-bit words
+    uint32_t _data[EntryCount][SectorSize / 4];
+};
+
+} // namespace fs
@@ -10,7 +10,8 @@ extern "C" {
 namespace fs {
 
 Volume::Volume(SdCard &sdcard) :
-    _sdcard(sdcard)
+    _sdcard(sdcard),
+    _sectorCache(sdcard)
 {
     setVolume(this);
 }
@@ -21,7 +22,12 @@ Volume::~Volume() {
 }
 
 bool Volume::available() {
-    return _sdcard.available();
+    if (!_sdcard.available()) {
+        // cached sectors can no longer be written back
+        _sectorCache.invalidate();
+        return false;
+    }
+    return true;
 }
 
 Error Volume::format() {
@@ -41,6 +47,7 @@ Error Volume::mount() {
 }
 
 Error Volume::unmount() {
+    _sectorCache.flush();
     return Error(f_mount(nullptr, "", 0));
 }
 
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Error.h"
+#include "SectorCache.h"
 
 #include "drivers/SdCard.h"
 
@@ -15,7 +16,12 @@ public:
     ~Volume();
 
     SdCard &sdcard() { return _sdcard; }
+    SectorCache &sectorCache() { return _sectorCache; }
 
+    // FatFs accesses FAT and directory sectors through the window buffer
+    bool isWindowBuffer(const void *buf) const { return buf == _fs.win; }
+
+    // also drops the cached sectors if the card was removed
     bool available();
 
     Error format();
@@ -29,6 +35,7 @@ public:
 
 private:
     SdCard &_sdcard;
+    SectorCache _sectorCache;
     FATFS _fs;
 };
 
@@ -1,23 +1,61 @@
 #pragma once
 
+#include <algorithm>
+
 #include <cstdint>
 
+// Blend operations on single pixels and on words of 4 pixels.
+// Word operations work on 4 packed 8-bit pixels and use the Cortex-M4 SIMD instructions if available.
 namespace blit {
     struct set {
+        static inline uint8_t pixel(uint8_t dst, uint8_t color) {
+            return color;
+        }
+        static inline uint32_t word(uint32_t dst, uint32_t color) {
+            return color;
+        }
         void operator()(FrameBuffer8bit &frameBuffer, int x, int y, uint8_t color) {
             frameBuffer(x, y) = color;
         }
     };
     struct add {
+        static inline uint8_t pixel(uint8_t dst, uint8_t color) {
+            // return std::min(0xff, int(dst) + color);
+            return dst + color;
+        }
+        static inline uint32_t word(uint32_t dst, uint32_t color) {
+            // per byte (wrapping) add, same as pixel()
+#if defined(__ARM_FEATURE_SIMD32)
+            uint32_t result;
+            asm ("uadd8 %0, %1, %2" : "=r" (result) : "r" (dst), "r" (color));
+            return result;
+#else
+            return ((dst & 0x7f7f7f7f) + (color & 0x7f7f7f7f)) ^ ((dst ^ color) & 0x80808080);
+#endif
+        }
         void operator()(FrameBuffer8bit &frameBuffer, int x, int y, uint8_t color) {
-            // frameBuffer(x, y) = std::min(0xff, int(frameBuffer(x, y)) + color);
-            frameBuffer(x, y) += color;
+            frameBuffer(x, y) = pixel(frameBuffer(x, y), color);
         }
     };
     struct sub {
+        static inline uint8_t pixel(uint8_t dst, uint8_t color) {
+            return dst - std::min(dst, color);
+        }
+        static inline uint32_t word(uint32_t dst, uint32_t color) {
+            // per byte saturating subtract, same as pixel()
+#if defined(__ARM_FEATURE_SIMD32)
+            uint32_t result;
+            asm ("uqsub8 %0, %1, %2" : "=r" (result) : "r" (dst), "r" (color));
+            return result;
+#else
+            // wrapping per byte subtract, then clear bytes which borrowed
+            uint32_t diff = ((dst | 0x80808080) - (color & 0x7f7f7f7f)) ^ ((dst ^ ~color) & 0x80808080);
+            uint32_t borrow = ((~dst & color) | (~(dst ^ color) & diff)) & 0x80808080;
+            return diff & ~((borrow >> 7) * 0xff);
+#endif
+        }
         void operator()(FrameBuffer8bit &frameBuffer, int x, int y, uint8_t color) {
-            // frameBuffer(x, y) = std::max(0x00, int(frameBuffer(x, y)) - color);
-            frameBuffer(x, y) -= std::min(frameBuffer(x, y), color);
+            frameBuffer(x, y) = pixel(frameBuffer(x, y), color);
         }
     };
 };
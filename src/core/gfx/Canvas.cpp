@@ -15,6 +15,53 @@ static const BitmapFont &bitmapFont(Font font) {
     }
 }
 
+// Glyph cache.
+// Font bitmaps store 1-bit glyphs as a continuous bit stream. The cache expands each glyph into
+// one bit mask per row at startup, so text is drawn without decoding the bit stream.
+template<int GlyphCount, int MaxHeight>
+class GlyphCache {
+public:
+    GlyphCache(const BitmapFont &font) {
+        static_assert(GlyphCount > 0, "invalid glyph count");
+        for (int index = 0; index < GlyphCount; ++index) {
+            const auto &g = font.glyphs[index];
+            const uint8_t *bitmap = &font.bitmap[g.offset];
+            int shift = 0;
+            for (int y = 0; y < MaxHeight; ++y) {
+                _rows[index][y] = 0;
+            }
+            for (int y = 0; y < g.height; ++y) {
+                for (int x = 0; x < g.width; ++x) {
+                    if (y < MaxHeight && x < 8 && ((*bitmap >> shift) & 1)) {
+                        _rows[index][y] |= 1 << x;
+                    }
+                    if (++shift >= 8) {
+                        ++bitmap;
+                        shift = 0;
+                    }
+                }
+            }
+        }
+    }
+
+    const uint8_t *rows(int index) const { return _rows[index]; }
+
+private:
+    uint8_t _rows[GlyphCount][MaxHeight];
+};
+
+static GlyphCache<126 - 32 + 1, 7> tiny5x5Cache(tiny5x5);
+static GlyphCache<126 - 16 + 1, 8> ati8x8Cache(ati8x8);
+
+// returns cached glyph rows or nullptr if the font is not cached
+static const uint8_t *cachedGlyph(Font font, int index) {
+    switch (font) {
+    case Font::Tiny: return tiny5x5Cache.rows(index);
+    case Font::Small: return ati8x8Cache.rows(index);
+    default: return nullptr;
+    }
+}
+
 static const int bitmapFontHeight(Font font) {
     switch (font) {
     case Font::Tiny: return 6;
@@ -104,6 +151,27 @@ void Canvas::drawBitmap4bit(int x, int y, int w, int h, const uint8_t *bitmap) {
     }
 }
 
+void Canvas::drawGlyph(int x, int y, int index) {
+    const auto &font = bitmapFont(_font);
+    const auto &g = font.glyphs[index];
+
+    const uint8_t *rows = cachedGlyph(_font, index);
+    if (rows) {
+        switch (_blendMode) {
+        case BlendMode::Set: drawGlyph<blit::set>(x + g.xOffset, y + g.yOffset, g.width, g.height, rows); break;
+        case BlendMode::Add: drawGlyph<blit::add>(x + g.xOffset, y + g.yOffset, g.width, g.height, rows); break;
+        case BlendMode::Sub: drawGlyph<blit::sub>(x + g.xOffset, y + g.yOffset, g.width, g.height, rows); break;
+        }
+        return;
+    }
+
+    const uint8_t *bitmap = &font.bitmap[g.offset];
+    switch (font.bpp) {
+    case 1: drawBitmap1bit(x + g.xOffset, y + g.yOffset, g.width, g.height, bitmap); break;
+    case 4: drawBitmap4bit(x + g.xOffset, y + g.yOffset, g.width, g.height, bitmap); break;
+    }
+}
+
 void Canvas::drawText(int x, int y, const char *str) {
     const auto &font = bitmapFont(_font);
 
@@ -119,11 +187,7 @@ void Canvas::drawText(int x, int y, const char *str) {
             continue;
         }
         const auto &g = font.glyphs[c - font.first];
-        const uint8_t *bitmap = &font.bitmap[g.offset];
-        switch (font.bpp) {
-        case 1: drawBitmap1bit(x + g.xOffset, y + g.yOffset, g.width, g.height, bitmap); break;
-        case 4: drawBitmap4bit(x + g.xOffset, y + g.yOffset, g.width, g.height, bitmap); break;
-        }
+        drawGlyph(x, y, c - font.first);
         x += g.xAdvance;
     }
 }
@@ -182,11 +246,7 @@ void Canvas::drawTextMultiline(int x, int y, int w, const char *str) {
             str--;
             continue;
         }
-        const uint8_t *bitmap = &font.bitmap[g.offset];
-        switch (font.bpp) {
-        case 1: drawBitmap1bit(x + g.xOffset, y + g.yOffset, g.width, g.height, bitmap); break;
-        case 4: drawBitmap4bit(x + g.xOffset, y + g.yOffset, g.width, g.height, bitmap); break;
-        }
+        drawGlyph(x, y, c - font.first);
         x += g.xAdvance;
     }
 }
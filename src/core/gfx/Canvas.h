@@ -6,6 +6,7 @@
 
 #include <cmath>
 #include <cstdint>
+#include <cstring>
 
 enum class BlendMode {
     Set,
@@ -119,16 +120,38 @@ private:
         }
     }
 
+    // blends a horizontal run of pixels, processing 4 pixels at once where possible
+    template<typename Blit>
+    void span(uint8_t *dst, int count) {
+        uint8_t color = _color;
+        while (count > 0 && (reinterpret_cast<uintptr_t>(dst) & 3)) {
+            *dst = Blit::pixel(*dst, color);
+            ++dst;
+            --count;
+        }
+        uint32_t color4 = color * 0x01010101u;
+        while (count >= 4) {
+            uint32_t word;
+            std::memcpy(&word, dst, sizeof(word));
+            word = Blit::word(word, color4);
+            std::memcpy(dst, &word, sizeof(word));
+            dst += 4;
+            count -= 4;
+        }
+        while (count > 0) {
+            *dst = Blit::pixel(*dst, color);
+            ++dst;
+            --count;
+        }
+    }
+
     template<typename Blit>
     void hline(int x, int y, int w) {
-        Blit blit;
         if (vinside(y)) {
             int x0 = x, x1 = x + w - 1;
             hclip(x0);
             hclip(x1);
-            for (int x = x0; x <= x1; ++x) {
-                blit(_frameBuffer, x, y, _color);
-            }
+            span<Blit>(&_frameBuffer(x0, y), x1 - x0 + 1);
         }
     }
 
@@ -230,15 +253,12 @@ private:
 
     template<typename Blit>
     void fillRect(int x, int y, int w, int h) {
-        Blit blit;
         int x0 = x, x1 = x + w - 1;
         int y0 = y, y1 = y + h - 1;
         clip(x0, y0);
         clip(x1, y1);
         for (int y = y0; y <= y1; ++y) {
-            for (int x = x0; x <= x1; ++x) {
-                blit(_frameBuffer, x, y, _color);
-            }
+            span<Blit>(&_frameBuffer(x0, y), x1 - x0 + 1);
         }
     }
 
@@ -269,6 +289,36 @@ private:
         }
     }
 
+    // draws a 1-bit glyph given as one bit mask per row (bit 0 is the leftmost pixel)
+    template<typename Blit>
+    void drawGlyph(int x, int y, int w, int h, const uint8_t *rows) {
+        Blit blit;
+        int x0 = x, x1 = x + w - 1;
+        int y0 = y, y1 = y + h - 1;
+        if (x0 > _right || x1 < 0 || y0 > _bottom || y1 < 0) {
+            return;
+        }
+
+        bool clipped = x0 < 0 || x1 > _right;
+        for (int y = std::max(0, y0); y <= std::min(_bottom, y1); ++y) {
+            uint8_t mask = rows[y - y0];
+            if (clipped) {
+                for (int x = x0; x <= x1; ++x) {
+                    if (hinside(x)) {
+                        blit(_frameBuffer, x, y, ((mask >> (x - x0)) & 1) * _color);
+                    }
+                }
+            } else {
+                uint8_t *dst = &_frameBuffer(x0, y);
+                for (int i = 0; i < w; ++i) {
+                    dst[i] = Blit::pixel(dst[i], ((mask >> i) & 1) * _color);
+                }
+            }
+        }
+    }
+
+    void drawGlyph(int x, int y, int index);
+
     FrameBuffer8bit &_frameBuffer;
     int _right;
     int _bottom;
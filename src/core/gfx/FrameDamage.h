@@ -0,0 +1,97 @@
+#pragma once
+
+#include <algorithm>
+
+#include <cstdint>
+#include <cstdlib>
+
+// Damage tracking for 4-bit grayscale displays.
+// Converts an 8-bit frame buffer into the packed 4-bit display format (2 pixels per byte) and
+// compares it to the previously packed frame. Changed rows are grouped into windows of consecutive
+// rows spanning the union of their changed columns. Window columns are in bytes and aligned to
+// ColumnAlign bytes to match the display's column addressing.
+template<int Width, int Height, int ColumnAlign, int MaxWindows>
+class FrameDamage {
+public:
+    static constexpr int RowBytes = Width / 2;
+
+    static_assert(RowBytes % ColumnAlign == 0, "row size must be a multiple of the column alignment");
+
+    struct Window {
+        uint8_t row0;
+        uint8_t row1;
+        uint8_t col0;
+        uint8_t col1;
+
+        int rows() const { return row1 - row0 + 1; }
+        int cols() const { return col1 - col0 + 1; }
+        int size() const { return rows() * cols(); }
+        bool fullWidth() const { return col0 == 0 && col1 == RowBytes - 1; }
+    };
+
+    // force the next update to report the full frame (e.g. display content is unknown)
+    void invalidate() { _invalid = true; }
+
+    int windowCount() const { return _windowCount; }
+    const Window &window(int index) const { return _windows[index]; }
+
+    // number of pixel bytes covered by all windows
+    int size() const {
+        int size = 0;
+        for (int i = 0; i < _windowCount; ++i) {
+            size += _windows[i].size();
+        }
+        return size;
+    }
+
+    // packs src (8-bit per pixel) into dst (4-bit per pixel) holding the previous frame and updates the windows
+    void update(const uint8_t *src, uint8_t *dst) {
+        _windowCount = 0;
+
+        for (int y = 0; y < Height; ++y) {
+            int col0 = RowBytes;
+            int col1 = -1;
+            for (int x = 0; x < RowBytes; ++x) {
+                uint8_t a = *src++;
+                uint8_t b = *src++;
+                uint8_t packed = std::min(b, uint8_t(15)) | (std::min(a, uint8_t(15)) << 4);
+                if (packed != *dst) {
+                    *dst = packed;
+                    col0 = std::min(col0, x);
+                    col1 = x;
+                }
+                ++dst;
+            }
+
+            if (_invalid) {
+                col0 = 0;
+                col1 = RowBytes - 1;
+            }
+
+            if (col1 >= 0) {
+                addRow(y, col0 - col0 % ColumnAlign, col1 - col1 % ColumnAlign + ColumnAlign - 1);
+            }
+        }
+
+        _invalid = false;
+    }
+
+private:
+    void addRow(int row, int col0, int col1) {
+        if (_windowCount > 0) {
+            auto &last = _windows[_windowCount - 1];
+            // extend the last window with consecutive rows, merge all remaining rows if out of windows
+            if (last.row1 == row - 1 || _windowCount == MaxWindows) {
+                last.row1 = row;
+                last.col0 = std::min(int(last.col0), col0);
+                last.col1 = std::max(int(last.col1), col1);
+                return;
+            }
+        }
+        _windows[_windowCount++] = { uint8_t(row), uint8_t(row), uint8_t(col0), uint8_t(col1) };
+    }
+
+    Window _windows[MaxWindows];
+    int _windowCount = 0;
+    bool _invalid = true;
+};
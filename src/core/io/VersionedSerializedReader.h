@@ -12,11 +12,27 @@ public:
 
     VersionedSerializedReader(Reader reader, uint32_t readerVersion) :
         _reader(reader),
+        _source(&_reader),
+        _readSource(&readFunction),
         _readerVersion(readerVersion)
     {
-        _reader(&_dataVersion, sizeof(_dataVersion));
+        readSource(&_dataVersion, sizeof(_dataVersion));
     }
 
+    // Streams from any source providing read(void *data, size_t len) without going through a std::function.
+    // The source needs to outlive the reader.
+    template<typename Source>
+    VersionedSerializedReader(Source &source, uint32_t readerVersion) :
+        _source(&source),
+        _readSource(&readFromSource<Source>),
+        _readerVersion(readerVersion)
+    {
+        readSource(&_dataVersion, sizeof(_dataVersion));
+    }
+
+    VersionedSerializedReader(const VersionedSerializedReader &) = delete;
+    VersionedSerializedReader &operator=(const VersionedSerializedReader &) = delete;
+
     uint32_t readerVersion() const { return _readerVersion; }
     uint32_t dataVersion() const { return _dataVersion; }
 
@@ -53,7 +69,7 @@ public:
 
     void read(void *data, size_t len, uint32_t addedInVersion) {
         if (_dataVersion >= addedInVersion) {
-            _reader(data, len);
+            readSource(data, len);
             _hash(data, len);
         }
     }
@@ -66,14 +82,14 @@ public:
     void skip(size_t len, uint32_t addedInVersion, uint32_t removedInVersion) {
         if (_dataVersion >= addedInVersion && _dataVersion < removedInVersion) {
             uint8_t dummy[len];
-            _reader(dummy, len);
+            readSource(dummy, len);
             _hash(dummy, len);
         }
     }
 
     bool checkHash() {
         uint32_t hash;
-        _reader(&hash, sizeof(hash));
+        readSource(&hash, sizeof(hash));
         return _hash.result() == hash;
     }
 
@@ -86,7 +102,24 @@ public:
     }
 
 private:
+    typedef void (*ReadSource)(void *, void *, size_t);
+
+    void readSource(void *data, size_t len) {
+        _readSource(_source, data, len);
+    }
+
+    static void readFunction(void *reader, void *data, size_t len) {
+        (*static_cast<Reader *>(reader))(data, len);
+    }
+
+    template<typename Source>
+    static void readFromSource(void *source, void *data, size_t len) {
+        static_cast<Source *>(source)->read(data, len);
+    }
+
     Reader _reader;
+    void *_source;
+    ReadSource _readSource;
     uint32_t _readerVersion;
     uint32_t _dataVersion;
     FnvHash _hash;
@@ -12,11 +12,27 @@ public:
 
     VersionedSerializedWriter(Writer writer, uint32_t writerVersion) :
         _writer(writer),
+        _sink(&_writer),
+        _writeSink(&writeFunction),
         _writerVersion(writerVersion)
     {
-        _writer(&_writerVersion, sizeof(_writerVersion));
+        writeSink(&_writerVersion, sizeof(_writerVersion));
     }
 
+    // Streams to any sink providing write(const void *data, size_t len) without going through a std::function.
+    // The sink needs to outlive the writer.
+    template<typename Sink>
+    VersionedSerializedWriter(Sink &sink, uint32_t writerVersion) :
+        _sink(&sink),
+        _writeSink(&writeToSink<Sink>),
+        _writerVersion(writerVersion)
+    {
+        writeSink(&_writerVersion, sizeof(_writerVersion));
+    }
+
+    VersionedSerializedWriter(const VersionedSerializedWriter &) = delete;
+    VersionedSerializedWriter &operator=(const VersionedSerializedWriter &) = delete;
+
     uint32_t writerVersion() const { return _writerVersion; }
 
     template<typename T>
@@ -32,16 +48,33 @@ public:
 
     void write(const void *data, size_t len) {
         _hash(data, len);
-        _writer(data, len);
+        writeSink(data, len);
     }
 
     void writeHash() {
         uint32_t hash = _hash.result();
-        _writer(&hash, sizeof(hash));
+        writeSink(&hash, sizeof(hash));
     }
 
 private:
+    typedef void (*WriteSink)(void *, const void *, size_t);
+
+    void writeSink(const void *data, size_t len) {
+        _writeSink(_sink, data, len);
+    }
+
+    static void writeFunction(void *writer, const void *data, size_t len) {
+        (*static_cast<Writer *>(writer))(data, len);
+    }
+
+    template<typename Sink>
+    static void writeToSink(void *sink, const void *data, size_t len) {
+        static_cast<Sink *>(sink)->write(data, len);
+    }
+
     Writer _writer;
+    void *_sink;
+    WriteSink _writeSink;
     uint32_t _writerVersion;
     FnvHash _hash;
 };
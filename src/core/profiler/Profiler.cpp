@@ -15,10 +15,29 @@ void Profiler::dump() {
     DBG("Profiler:");
     DBG("---------------------------------------------");
     if (_numIntervals > 0) {
-        DBG("Intervals:");
+        DBG("Intervals (min/mean/max us):");
         for (int i = 0; i < _numIntervals; ++i) {
             const auto &interval = *_intervals[i];
-            DBG("  %s: %lu us", interval.desc, interval.avg);
+            if (interval.count == 0) {
+                DBG("  %s: -", interval.desc);
+                continue;
+            }
+            DBG("  %s: %lu/%lu/%lu us (n=%lu)",
+                interval.desc,
+                cyclesToUs(interval.min),
+                cyclesToUs(interval.mean()),
+                cyclesToUs(interval.max),
+                interval.count
+            );
+            for (int bin = 0; bin < HistogramBins; ++bin) {
+                if (interval.histogram[bin] > 0) {
+                    if (bin < HistogramBins - 1) {
+                        DBG("    < %5lu us: %lu", binLimitUs(bin), interval.histogram[bin]);
+                    } else {
+                        DBG("    >=%5lu us: %lu", binLimitUs(bin - 1), interval.histogram[bin]);
+                    }
+                }
+            }
         }
     }
     if (_numCounters > 0) {
@@ -31,6 +50,15 @@ void Profiler::dump() {
     DBG("---------------------------------------------");
 }
 
+void Profiler::reset() {
+    for (int i = 0; i < _numIntervals; ++i) {
+        _intervals[i]->reset();
+    }
+    for (int i = 0; i < _numCounters; ++i) {
+        _counters[i]->count = 0;
+    }
+}
+
 void Profiler::registerInterval(Interval *interval) {
     if (_numIntervals < MaxIntervals) {
         _intervals[_numIntervals++] = interval;
@@ -8,28 +8,89 @@
 
 #if CONFIG_ENABLE_PROFILER
 
+// Lightweight profiler for measuring code sections.
+// Intervals are measured in CPU cycles and keep min/max/mean as well as a latency histogram.
+// Recording is lock-free and may be used from both task and interrupt context as long as
+// each interval is only recorded from a single context.
 class Profiler {
 public:
+    // Histogram bin 0 counts durations below 1us, bin i counts durations in [2^(i-1), 2^i) us.
+    // The last bin collects all longer durations.
+    static const int HistogramBins = 16;
+
     static void init();
     static void dump();
+    static void reset();
+
+    static uint32_t cyclesToUs(uint32_t cycles) {
+        return cycles / (CONFIG_CPU_FREQUENCY / 1000000);
+    }
+
+    static uint32_t binLimitUs(int bin) {
+        return bin < HistogramBins - 1 ? (1 << bin) : 0xffffffff;
+    }
 
     struct Interval {
         Interval(const char *desc) : desc(desc) {
+            reset();
             registerInterval(this);
         }
 
         inline void begin() {
-            start = HighResolutionTimer::us();
+            start = HighResolutionTimer::cycles();
         }
 
         inline void end() {
-            uint32_t end = HighResolutionTimer::us();
-            avg = end - start;
+            record(HighResolutionTimer::cycles() - start);
+        }
+
+        inline void record(uint32_t cycles) {
+            last = cycles;
+            min = cycles < min ? cycles : min;
+            max = cycles > max ? cycles : max;
+            total += cycles;
+            ++count;
+
+            uint32_t us = cyclesToUs(cycles);
+            int bin = us == 0 ? 0 : 32 - __builtin_clz(us);
+            ++histogram[bin < HistogramBins ? bin : HistogramBins - 1];
+        }
+
+        void reset() {
+            count = 0;
+            total = 0;
+            min = 0xffffffff;
+            max = 0;
+            last = 0;
+            for (auto &bin : histogram) {
+                bin = 0;
+            }
+        }
+
+        uint32_t mean() const {
+            return count > 0 ? total / count : 0;
         }
 
         const char *desc;
         uint32_t start;
-        uint32_t avg;
+        uint32_t count;
+        uint64_t total;
+        uint32_t min;
+        uint32_t max;
+        uint32_t last;
+        uint32_t histogram[HistogramBins];
+    };
+
+    struct IntervalScope {
+        IntervalScope(Interval &interval) : interval(interval) {
+            interval.begin();
+        }
+
+        ~IntervalScope() {
+            interval.end();
+        }
+
+        Interval &interval;
     };
 
     struct Counter {
@@ -42,9 +103,15 @@ public:
         }
 
         const char *desc;
-        uint32_t count;
+        uint32_t count = 0;
     };
 
+    static int intervalCount() { return _numIntervals; }
+    static const Interval &interval(int index) { return *_intervals[index]; }
+
+    static int counterCount() { return _numCounters; }
+    static const Counter &counter(int index) { return *_counters[index]; }
+
 private:
     static const int MaxIntervals = 16;
     static const int MaxCounters = 16;
@@ -64,10 +131,12 @@ private:
     _name_##_profiler_interval.begin();
 # define PROFILER_INTERVAL_END(_name_) \
     _name_##_profiler_interval.end();
+# define PROFILER_INTERVAL_SCOPE(_name_) \
+    Profiler::IntervalScope _name_##_profiler_interval_scope(_name_##_profiler_interval);
 
 # define PROFILER_COUNTER(_name_, _desc_) \
     static Profiler::Counter _name_##_profiler_counter(_desc_);
-# define PROFILER_COUNTER_ADD(_num_) \
+# define PROFILER_COUNTER_ADD(_name_, _num_) \
     _name_##_profiler_counter.add(_num_);
 
 #else // CONFIG_ENABLE_PROFILER
@@ -76,13 +145,15 @@ class Profiler {
 public:
     static void init() {}
     static void dump() {}
+    static void reset() {}
 };
 
 # define PROFILER_INTERVAL(_name_, _desc_)
 # define PROFILER_INTERVAL_BEGIN(_name_)
 # define PROFILER_INTERVAL_END(_name_)
+# define PROFILER_INTERVAL_SCOPE(_name_)
 
 # define PROFILER_COUNTER(_name_, _desc_)
-# define PROFILER_COUNTER_ADD(_num_)
+# define PROFILER_COUNTER_ADD(_name_, _num_)
 
 #endif // CONFIG_ENABLE_PROFILER
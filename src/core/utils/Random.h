@@ -30,6 +30,16 @@ public:
         return next() / (0xffffffff / range);
     }
 
+    // scrambles a seed so that consecutive seeds start unrelated sequences
+    static uint32_t hash(uint32_t x) {
+        x ^= x >> 16;
+        x *= 0x85ebca6b;
+        x ^= x >> 13;
+        x *= 0xc2b2ae35;
+        x ^= x >> 16;
+        return x;
+    }
+
 private:
     uint32_t _state;
 };
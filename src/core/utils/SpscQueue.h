@@ -0,0 +1,118 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+
+#include <cstddef>
+#include <cstdint>
+
+// Lock-free single-producer/single-consumer queue.
+// One context (task or interrupt) may write while another one reads without any locking. Indices are free running
+// and masked on access, so Size must be a power of two. The producer publishes items with a release store to the
+// write index, the consumer frees slots with a release store to the read index. Items that do not fit are dropped
+// and counted, the producer side decides what to do with a full queue before writing.
+template<typename T, size_t Size>
+class SpscQueue {
+public:
+    static_assert(Size > 0 && (Size & (Size - 1)) == 0, "size must be a power of two");
+
+    inline size_t size() const { return Size; }
+
+    // consumer side
+    inline size_t readable() const {
+        return _write.load(std::memory_order_acquire) - _read.load(std::memory_order_relaxed);
+    }
+
+    inline bool empty() const { return readable() == 0; }
+
+    // producer side
+    inline size_t writable() const {
+        return Size - (_write.load(std::memory_order_relaxed) - _read.load(std::memory_order_acquire));
+    }
+
+    inline bool full() const { return writable() == 0; }
+
+    // number of items dropped because the queue was full
+    inline uint32_t dropped() const { return _dropped.load(std::memory_order_relaxed); }
+
+    inline bool write(const T &value) {
+        uint32_t write = _write.load(std::memory_order_relaxed);
+        if (write - _read.load(std::memory_order_acquire) == Size) {
+            drop(1);
+            return false;
+        }
+        _buffer[write & Mask] = value;
+        _write.store(write + 1, std::memory_order_release);
+        return true;
+    }
+
+    // writes as many items as fit and returns their number, the remaining ones are dropped
+    inline size_t write(const T *data, size_t length) {
+        uint32_t write = _write.load(std::memory_order_relaxed);
+        size_t count = std::min(length, Size - (write - _read.load(std::memory_order_acquire)));
+        for (size_t i = 0; i < count; ++i) {
+            _buffer[(write + i) & Mask] = data[i];
+        }
+        _write.store(write + count, std::memory_order_release);
+        if (count < length) {
+            drop(length - count);
+        }
+        return count;
+    }
+
+    inline bool read(T &value) {
+        uint32_t read = _read.load(std::memory_order_relaxed);
+        if (_write.load(std::memory_order_acquire) == read) {
+            return false;
+        }
+        value = _buffer[read & Mask];
+        _read.store(read + 1, std::memory_order_release);
+        return true;
+    }
+
+    // returns the next item without removing it
+    inline bool peek(T &value) const {
+        uint32_t read = _read.load(std::memory_order_relaxed);
+        if (_write.load(std::memory_order_acquire) == read) {
+            return false;
+        }
+        value = _buffer[read & Mask];
+        return true;
+    }
+
+    // reads and replaces the slot, used to release resources held by the item (i.e. midi payloads)
+    inline bool readAndReplace(T &value, const T &replacement = T()) {
+        uint32_t read = _read.load(std::memory_order_relaxed);
+        if (_write.load(std::memory_order_acquire) == read) {
+            return false;
+        }
+        value = _buffer[read & Mask];
+        _buffer[read & Mask] = replacement;
+        _read.store(read + 1, std::memory_order_release);
+        return true;
+    }
+
+    // reads up to length items and returns their number
+    inline size_t read(T *data, size_t length) {
+        uint32_t read = _read.load(std::memory_order_relaxed);
+        size_t count = std::min(length, size_t(_write.load(std::memory_order_acquire) - read));
+        for (size_t i = 0; i < count; ++i) {
+            data[i] = _buffer[(read + i) & Mask];
+        }
+        _read.store(read + count, std::memory_order_release);
+        return count;
+    }
+
+private:
+    static constexpr uint32_t Mask = Size - 1;
+
+    inline void drop(size_t count) {
+        // only the producer modifies the counter
+        _dropped.store(_dropped.load(std::memory_order_relaxed) + count, std::memory_order_relaxed);
+    }
+
+    T _buffer[Size];
+    std::atomic<uint32_t> _write { 0 };
+    std::atomic<uint32_t> _read { 0 };
+    std::atomic<uint32_t> _dropped { 0 };
+};
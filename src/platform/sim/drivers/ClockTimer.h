@@ -2,6 +2,8 @@
 
 #include "sim/Simulator.h"
 
+#include <algorithm>
+
 #include <cstdint>
 
 class ClockTimer {
@@ -10,6 +12,15 @@ public:
         virtual void onClockTimerTick() = 0;
     };
 
+    // the simulator polls the timer once per step, ticks are delivered late by up to a step
+    struct Jitter {
+        uint32_t count = 0;
+        double totalUs = 0.0;
+        double maxUs = 0.0;
+
+        double averageUs() const { return count > 0 ? totalUs / count : 0.0; }
+    };
+
     ClockTimer() :
         _simulator(sim::Simulator::instance())
     {
@@ -25,7 +36,7 @@ public:
 
     void enable() {
         _enabled = true;
-        _lastTicks = _simulator.ticks();
+        _lastTicks = _ticks;
     }
 
     void disable() {
@@ -45,24 +56,39 @@ public:
         _listener = listener;
     }
 
-private:
-    void update() {
+    const Jitter &jitter() const { return _jitter; }
+    void resetJitter() { _jitter = Jitter(); }
+
+    // runs all timer periods up to the given time (in simulator ticks)
+    // called on every simulator step, analysis tools call it directly to run the timer at a finer resolution
+    void advance(double ticks) {
+        _ticks = ticks;
         if (!_enabled) {
             return;
         }
-        double ticks = _simulator.ticks();
         while (ticks - _lastTicks >= _periodTicks) {
             _lastTicks += _periodTicks;
+            double lateUs = (ticks - _lastTicks) * 1000.0;
+            _jitter.count += 1;
+            _jitter.totalUs += lateUs;
+            _jitter.maxUs = std::max(_jitter.maxUs, lateUs);
             if (_listener) {
                 _listener->onClockTimerTick();
             }
         }
     }
 
+private:
+    void update() {
+        advance(_simulator.ticks());
+    }
+
     sim::Simulator &_simulator;
     uint32_t _period = 0;
     double _periodTicks = 0.0;
     Listener *_listener = nullptr;
     bool _enabled = false;
+    double _ticks = 0.0;
     double _lastTicks;
+    Jitter _jitter;
 };
@@ -25,6 +25,7 @@ public:
 
     void write(int channel) {
         _simulator.writeDac(channel, _values[channel]);
+        ++_writeCount;
     }
 
     void write() {
@@ -33,7 +34,20 @@ public:
         }
     }
 
+    // writes the channels in the mask and updates their outputs at once
+    void writeChannels(uint32_t channels) {
+        for (int channel = 0; channels; ++channel, channels >>= 1) {
+            if (channels & 1) {
+                write(channel);
+            }
+        }
+    }
+
+    // number of channel values written
+    uint32_t writeCount() const { return _writeCount; }
+
 private:
     sim::Simulator &_simulator;
     Value _values[Channels];
+    uint32_t _writeCount = 0;
 };
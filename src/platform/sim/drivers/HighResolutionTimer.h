@@ -1,5 +1,9 @@
 #pragma once
 
+#include "SystemConfig.h"
+
+#include "sim/Simulator.h"
+
 #include <chrono>
 
 #include <cstdint>
@@ -15,9 +19,21 @@ public:
     }
 
     static uint32_t us() {
+        // follow the simulator's virtual clock when rendering offline
+        if (sim::Simulator::hasInstance() && sim::Simulator::instance().offline()) {
+            return uint32_t(sim::Simulator::instance().ticks() * 1000.0);
+        }
+
         auto current = std::chrono::high_resolution_clock::now();
 
         return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::duration<double>(current - detail::start)).count();
     }
 
+    // emulated CPU cycle counter, always based on host time so profiling works in offline mode
+    static uint32_t cycles() {
+        auto current = std::chrono::high_resolution_clock::now();
+
+        return uint64_t(std::chrono::duration_cast<std::chrono::nanoseconds>(current - detail::start).count()) * (CONFIG_CPU_FREQUENCY / 1000000) / 1000;
+    }
+
 };
@@ -5,6 +5,8 @@
 
 #include "SystemConfig.h"
 
+#include "core/gfx/FrameDamage.h"
+
 #include <cstdint>
 #include <cstring>
 
@@ -22,9 +24,33 @@ public:
     void draw(uint8_t *frameBuffer) {
         std::memcpy(_frameBuffer.data(), frameBuffer, _frameBuffer.size());
         _simulator.writeLcd(_frameBuffer);
+
+        // track the number of bytes the hardware driver would transfer
+        _damage.update(frameBuffer, _packedFrameBuffer);
+        _lastFrameBytes = _damage.size();
+        for (int i = 0; i < _damage.windowCount(); ++i) {
+            _lastFrameBytes += CommandBytes;
+        }
+        _totalBytes += _lastFrameBytes;
+        ++_frames;
     }
 
+    // transfer statistics (pixel data and window commands)
+    uint32_t frames() const { return _frames; }
+    uint64_t totalBytes() const { return _totalBytes; }
+    uint32_t lastFrameBytes() const { return _lastFrameBytes; }
+    void resetStats() { _frames = 0; _totalBytes = 0; }
+    static constexpr uint32_t FullFrameBytes = Width * Height / 2 + 7;
+
 private:
+    // set column (3), set row (3), write ram (1)
+    static constexpr uint32_t CommandBytes = 7;
+
     sim::Simulator &_simulator;
     sim::FrameBuffer _frameBuffer;
+    FrameDamage<Width, Height, 2, 8> _damage;
+    uint8_t _packedFrameBuffer[Width * Height / 2] = {};
+    uint32_t _frames = 0;
+    uint64_t _totalBytes = 0;
+    uint32_t _lastFrameBytes = 0;
 };
@@ -1,11 +1,11 @@
 #pragma once
 
 #include "core/midi/MidiMessage.h"
+#include "core/utils/SpscQueue.h"
 
 #include "sim/Simulator.h"
 
 #include <functional>
-#include <deque>
 
 #include <cstdint>
 
@@ -27,30 +27,27 @@ public:
     }
 
     bool recv(MidiMessage *message) {
-        if (!_recvQueue.empty()) {
-            *message = _recvQueue.front();
-            _recvQueue.pop_front();
-            return true;
-        }
-        return false;
+        return _recvQueue.readAndReplace(*message);
     }
 
     void setRecvFilter(RecvFilter filter) {
         _recvFilter = filter;
     }
 
-    uint32_t rxOverflow() const { return 0; }
+    uint32_t rxOverflow() const { return _recvQueue.dropped(); }
 
 private:
     void writeMidiInput(sim::MidiEvent event) {
         if (event.port == 0 && event.kind == sim::MidiEvent::Message) {
             if (event.message.length() != 1 || !_recvFilter || !_recvFilter(event.message.status())) {
-                _recvQueue.emplace_back(event.message);
+                // drops and counts the message if the queue is full
+                _recvQueue.write(event.message);
             }
         }
     }
 
     sim::Simulator &_simulator;
-    std::deque<MidiMessage> _recvQueue;
+    // holds about as many messages as the 64 byte receive buffer on the hardware
+    SpscQueue<MidiMessage, 32> _recvQueue;
     RecvFilter _recvFilter;
 };
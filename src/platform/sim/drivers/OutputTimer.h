@@ -0,0 +1,46 @@
+#pragma once
+
+#include "sim/Simulator.h"
+
+#include <cstdint>
+
+class OutputTimer {
+public:
+    struct Listener {
+        virtual void onOutputTimer() = 0;
+    };
+
+    OutputTimer() :
+        _simulator(sim::Simulator::instance())
+    {
+        _simulator.addUpdateCallback([this] () { update(); });
+    }
+
+    void init() {
+    }
+
+    void schedule(uint32_t us) {
+        _armed = true;
+        _targetTicks = _simulator.ticks() + us * 0.001;
+    }
+
+    void setListener(Listener *listener) {
+        _listener = listener;
+    }
+
+private:
+    void update() {
+        // the listener may reschedule, fire at most once per simulator step
+        if (_armed && _simulator.ticks() >= _targetTicks) {
+            _armed = false;
+            if (_listener) {
+                _listener->onOutputTimer();
+            }
+        }
+    }
+
+    sim::Simulator &_simulator;
+    Listener *_listener = nullptr;
+    bool _armed = false;
+    double _targetTicks;
+};
@@ -1,11 +1,11 @@
 #pragma once
 
 #include "core/midi/MidiMessage.h"
+#include "core/utils/SpscQueue.h"
 
 #include "sim/Simulator.h"
 
 #include <functional>
-#include <deque>
 #include <memory>
 
 #include <cstdint>
@@ -30,10 +30,8 @@ public:
     }
 
     bool recv(uint8_t *cable, MidiMessage *message) {
-        if (!_recvQueue.empty()) {
+        if (_recvQueue.readAndReplace(*message)) {
             *cable = 0;
-            *message = _recvQueue.front();
-            _recvQueue.pop_front();
             return true;
         }
         return false;
@@ -51,7 +49,11 @@ public:
         _recvFilter = filter;
     }
 
-    uint32_t rxOverflow() const { return 0; }
+    uint32_t rxOverflow() const { return _recvQueue.dropped(); }
+    uint32_t txOverflow() const { return 0; }
+
+    // messages are sent immediately, report the same capacity as the hardware transmit queue
+    uint32_t txAvailable() const { return 128; }
 
 private:
     void writeMidiInput(sim::MidiEvent event) {
@@ -69,7 +71,8 @@ private:
                 break;
             case sim::MidiEvent::Message:
                 if (event.message.length() != 1 || !_recvFilter || !_recvFilter(event.message.status())) {
-                    _recvQueue.emplace_back(event.message);
+                    // drops and counts the message if the queue is full
+                    _recvQueue.write(event.message);
                 }
                 break;
             }
@@ -81,5 +84,6 @@ private:
     RecvFilter _recvFilter;
 
     sim::Simulator &_simulator;
-    std::deque<MidiMessage> _recvQueue;
+    // same size as the receive queue on the hardware
+    SpscQueue<MidiMessage, 16> _recvQueue;
 };
@@ -0,0 +1,62 @@
+#include "OfflineRenderer.h"
+
+namespace sim {
+
+OfflineRenderer::OfflineRenderer(Simulator &simulator) :
+    _simulator(simulator)
+{
+    _simulator.registerTargetTickObserver(this);
+    _simulator.registerTargetOutputObserver(this);
+}
+
+void OfflineRenderer::render(int ms) {
+    bool offline = _simulator.offline();
+    _simulator.setOffline(true);
+
+    if (!_recording) {
+        _startTick = _simulator.ticks();
+        _recording = true;
+    }
+
+    _simulator.wait(ms);
+
+    _simulator.setOffline(offline);
+}
+
+void OfflineRenderer::saveToFile(const std::string &filename) const {
+    _targetTrace.saveToFile(filename);
+}
+
+void OfflineRenderer::saveToText(const std::string &filename) const {
+    _targetTrace.saveToText(filename);
+}
+
+// TargetTickHandler
+
+void OfflineRenderer::setTick(uint32_t tick) {
+    _tick = tick - _startTick;
+}
+
+// TargetOutputHandler
+
+void OfflineRenderer::writeGateOutput(int channel, bool value) {
+    _targetState.gateOutput.set(channel, value);
+    if (_recording) {
+        _targetTrace.gateOutput.write(_tick, _targetState.gateOutput);
+    }
+}
+
+void OfflineRenderer::writeDac(int channel, uint16_t value) {
+    _targetState.dac.set(channel, value);
+    if (_recording) {
+        _targetTrace.dac.write(_tick, _targetState.dac);
+    }
+}
+
+void OfflineRenderer::writeMidiOutput(MidiEvent event) {
+    if (_recording) {
+        _targetTrace.midiOutput.write(_tick, event);
+    }
+}
+
+} // namespace sim
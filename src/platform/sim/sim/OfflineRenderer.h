@@ -0,0 +1,44 @@
+#pragma once
+
+#include "Simulator.h"
+#include "TargetTrace.h"
+
+#include <string>
+
+#include <cstdint>
+
+namespace sim {
+
+// Runs the simulator on its virtual clock as fast as possible and records
+// all gate, CV and MIDI outputs of the target into a trace.
+class OfflineRenderer : public TargetTickHandler, public TargetOutputHandler {
+public:
+    OfflineRenderer(Simulator &simulator);
+
+    const TargetTrace &targetTrace() const { return _targetTrace; }
+
+    // render the given amount of time (in virtual milliseconds)
+    void render(int ms);
+
+    // writes the recorded outputs in binary/text form (see TargetTrace)
+    void saveToFile(const std::string &filename) const;
+    void saveToText(const std::string &filename) const;
+
+    // TargetTickHandler
+    virtual void setTick(uint32_t tick) override;
+
+    // TargetOutputHandler
+    virtual void writeGateOutput(int channel, bool value) override;
+    virtual void writeDac(int channel, uint16_t value) override;
+    virtual void writeMidiOutput(MidiEvent event) override;
+
+private:
+    Simulator &_simulator;
+    TargetState _targetState;
+    TargetTrace _targetTrace;
+    bool _recording = false;
+    uint32_t _startTick = 0;
+    uint32_t _tick = 0;
+};
+
+} // namespace sim
@@ -32,6 +32,10 @@ Simulator::~Simulator() {
     if (_targetCreated) {
        _target.destroy();
     }
+
+    if (g_instance == this) {
+        g_instance = nullptr;
+    }
 }
 
 void Simulator::wait(int ms) {
@@ -173,6 +177,10 @@ void Simulator::writeMidiOutput(MidiEvent event) {
     }
 }
 
+bool Simulator::hasInstance() {
+    return g_instance != nullptr;
+}
+
 Simulator &Simulator::instance() {
     return *g_instance;
 }
@@ -32,6 +32,11 @@ public:
 
     double ticks();
 
+    // In offline mode all target timers (including the high resolution timer) run on the
+    // simulator's virtual clock, allowing the target to run as fast as the host allows.
+    bool offline() const { return _offline; }
+    void setOffline(bool offline) { _offline = offline; }
+
     typedef std::function<void()> UpdateCallback;
 
     void addUpdateCallback(UpdateCallback callback);
@@ -57,6 +62,7 @@ public:
     void writeLcd(const FrameBuffer &frameBuffer) override;
     void writeMidiOutput(MidiEvent event) override;
 
+    static bool hasInstance();
     static Simulator &instance();
 
 private:
@@ -66,6 +72,7 @@ private:
     bool _targetCreated = false;
 
     uint32_t _tick = 0;
+    bool _offline = false;
 
     std::vector<TargetTickHandler *> _targetTickObservers;
     std::vector<TargetInputHandler *> _targetInputObservers;
@@ -70,12 +70,24 @@ void Dac::init() {
 
 void Dac::write(int channel) {
     writeDac(WRITE_INPUT_REGISTER_UPDATE_N, channel, _values[channel], 15);
+    ++_writeCount;
 }
 
 void Dac::write() {
     for (int channel = 0; channel < Channels; ++channel) {
         writeDac(channel == 7 ? WRITE_INPUT_REGISTER_UPDATE_ALL : WRITE_INPUT_REGISTER, channel, _values[channel], 0);
     }
+    _writeCount += Channels;
+}
+
+void Dac::writeChannels(uint32_t channels) {
+    // load input registers, the last write updates all outputs (input registers of other channels hold their output)
+    for (int channel = 0; channels; ++channel, channels >>= 1) {
+        if (channels & 1) {
+            writeDac(channels == 1 ? WRITE_INPUT_REGISTER_UPDATE_ALL : WRITE_INPUT_REGISTER, channel, _values[channel], 0);
+            ++_writeCount;
+        }
+    }
 }
 
 void Dac::writeDac(uint8_t command, uint8_t address, uint16_t data, uint8_t function) {
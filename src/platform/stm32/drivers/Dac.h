@@ -27,6 +27,12 @@ public:
     void write(int channel);
     void write();
 
+    // writes the channels in the mask and updates their outputs at once
+    void writeChannels(uint32_t channels);
+
+    // number of channel values written
+    uint32_t writeCount() const { return _writeCount; }
+
 private:
     void writeDac(uint8_t command, uint8_t address, uint16_t data, uint8_t function);
 
@@ -44,4 +50,5 @@ private:
 
     Value _values[Channels];
     uint32_t _dataShift = 0;
+    uint32_t _writeCount = 0;
 };
@@ -8,5 +8,7 @@ void GateOutput::init() {
 }
 
 void GateOutput::update() {
-    _shiftRegister.write(2, _gates);
+    // shift out right away instead of waiting for the driver task to keep gate timing exact,
+    // only the gate register is updated so the button inputs keep their scan timing
+    _shiftRegister.writeImmediate(2, _gates);
 }
@@ -29,6 +29,8 @@ void HighResolutionTimer::init() {
     timer_enable_update_event(TIMER);
     timer_enable_irq(TIMER, TIM_DIER_UIE);
     timer_enable_counter(TIMER);
+
+    dwt_enable_cycle_counter();
 }
 
 void tim2_isr() {
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <libopencm3/cm3/dwt.h>
+
 #include <cstdint>
 
 class HighResolutionTimer {
@@ -10,6 +12,11 @@ public:
         return _ticks;
     }
 
+    // CPU cycle counter (wraps around every ~25s at 168MHz)
+    static inline uint32_t cycles() {
+        return DWT_CYCCNT;
+    }
+
     static inline void tick() {
         ++_ticks;
     }
@@ -65,6 +65,8 @@ static InitCommand initCommands[] = {
     { 0x00 }
 };
 
+static Lcd *g_lcd = nullptr;
+
 #ifdef LCD_USE_DMA
 static volatile uint32_t txDone = 1;
 #endif // LCD_USE_DMA
@@ -76,6 +78,8 @@ static inline void waitTxDone() {
 
 
 void Lcd::init() {
+    g_lcd = this;
+
     // init spi pins
     rcc_periph_clock_enable(RCC_GPIOB);
     rcc_periph_clock_enable(RCC_GPIOC);
@@ -127,33 +131,89 @@ void Lcd::draw(uint8_t *frameBuffer) {
 #ifdef LCD_USE_DMA
     // wait until previous frame is sent
     while (!txDone) {}
-    txDone = 0;
 #endif // LCD_USE_DMA
 
-    // copy buffer
-    uint8_t *src = frameBuffer;
-    uint8_t *dst = reinterpret_cast<uint8_t *>(_frameBuffer);
-    for (int i = 0; i < Width * Height / 2; ++i) {
-        uint8_t a = *src++;
-        uint8_t b = *src++;
-        *dst++ = std::min(b, uint8_t(15)) | (std::min(a, uint8_t(15)) << 4);
-        // *dst++ = (b >> 4) | ((a >> 4) << 4);
+    // convert buffer and find changed regions
+    _damage.update(frameBuffer, reinterpret_cast<uint8_t *>(_frameBuffer));
+    if (_damage.windowCount() == 0) {
+        return;
+    }
+
+#ifdef LCD_USE_DMA
+
+    txDone = 0;
+    _windowIndex = 0;
+    startWindow();
+
+#else // LCD_USE_DMA
+
+    const uint8_t *data = reinterpret_cast<uint8_t *>(_frameBuffer);
+    for (_windowIndex = 0; _windowIndex < _damage.windowCount(); ++_windowIndex) {
+        const auto &window = _damage.window(_windowIndex);
+        setColAddr(0x1c + window.col0 / 2, 0x1c + window.col1 / 2);
+        setRowAddr(window.row0, window.row1);
+        setWrite();
+        for (int y = window.row0; y <= window.row1; ++y) {
+            for (int x = window.col0; x <= window.col1; ++x) {
+                sendData(data[y * Damage::RowBytes + x]);
+            }
+        }
     }
 
+#endif // LCD_USE_DMA
+}
 
+void Lcd::handleIrq() {
 #ifdef LCD_USE_DMA
+    if (dma_get_interrupt_flag(LCD_DMA, LCD_DMA_STREAM, DMA_TCIF)) {
+        dma_clear_interrupt_flags(LCD_DMA, LCD_DMA_STREAM, DMA_TCIF);
+        dma_disable_stream(LCD_DMA, LCD_DMA_STREAM);
+
+        spi_disable_tx_dma(LCD_SPI);
+
+        waitTxDone();
 
-    setColAddr(0x1c,0x5b);
-    setRowAddr(0x00,0x3f);
+        // continue with next row of the window or the next window
+        const auto &window = _damage.window(_windowIndex);
+        if (++_row <= window.row1) {
+            startTransfer();
+        } else if (++_windowIndex < _damage.windowCount()) {
+            startWindow();
+        } else {
+            txDone = 1;
+        }
+    }
+#endif // LCD_USE_DMA
+}
+
+void Lcd::startWindow() {
+    const auto &window = _damage.window(_windowIndex);
+    setColAddr(0x1c + window.col0 / 2, 0x1c + window.col1 / 2);
+    setRowAddr(window.row0, window.row1);
     setWrite();
+    _row = window.row0;
+    startTransfer();
+}
+
+void Lcd::startTransfer() {
+#ifdef LCD_USE_DMA
+    // rows of full width windows are contiguous and sent in a single transfer,
+    // otherwise each row is sent separately (the display keeps the window address)
+    const auto &window = _damage.window(_windowIndex);
+    const uint8_t *data = reinterpret_cast<uint8_t *>(_frameBuffer) + _row * Damage::RowBytes + window.col0;
+    size_t len = window.cols();
+    if (window.fullWidth()) {
+        len *= window.row1 - _row + 1;
+        _row = window.row1;
+    }
 
     waitTxDone();
     gpio_set(LCD_PORT, LCD_DC);
 
     dma_stream_reset(LCD_DMA, LCD_DMA_STREAM);
     dma_set_peripheral_address(LCD_DMA, LCD_DMA_STREAM, reinterpret_cast<uint32_t>(&LCD_SPI_DR));
-    dma_set_memory_address(LCD_DMA, LCD_DMA_STREAM, reinterpret_cast<uint32_t>(_frameBuffer));
-    dma_set_number_of_data(LCD_DMA, LCD_DMA_STREAM, sizeof(_frameBuffer));
+    dma_set_memory_address(LCD_DMA, LCD_DMA_STREAM, reinterpret_cast<uint32_t>(data));
+    dma_set_number_of_data(LCD_DMA, LCD_DMA_STREAM, len);
     dma_channel_select(LCD_DMA, LCD_DMA_STREAM, LCD_DMA_CHANNEL);
     dma_set_priority(LCD_DMA, LCD_DMA_STREAM, DMA_SxCR_PL_HIGH);
 
@@ -169,20 +229,6 @@ void Lcd::draw(uint8_t *frameBuffer) {
     dma_enable_stream(LCD_DMA, LCD_DMA_STREAM);
 
     spi_enable_tx_dma(LCD_SPI);
-
-#else // LCD_USE_DMA
-
-    setColAddr(0x1c,0x5b);
-    setRowAddr(0x00,0x3f);
-    setWrite();
-
-    src = reinterpret_cast<uint8_t *>(_frameBuffer);
-    for (int y = 0; y < Height; y++) {
-        for (int x = 0; x < Width/2; x++) {
-            sendData(*src++);
-        }
-    }
-
 #endif // LCD_USE_DMA
 }
 
@@ -230,15 +276,6 @@ void Lcd::setWrite() {
 
 #ifdef LCD_USE_DMA
 void dma1_stream4_isr(void) {
-    if (dma_get_interrupt_flag(LCD_DMA, LCD_DMA_STREAM, DMA_TCIF)) {
-        dma_clear_interrupt_flags(LCD_DMA, LCD_DMA_STREAM, DMA_TCIF);
-        dma_disable_stream(LCD_DMA, LCD_DMA_STREAM);
-
-        spi_disable_tx_dma(LCD_SPI);
-
-        waitTxDone();
-
-        txDone = 1;
-    }
+    g_lcd->handleIrq();
 }
 #endif // LCD_USE_DMA
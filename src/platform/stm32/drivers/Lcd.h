@@ -2,6 +2,8 @@
 
 #include "SystemConfig.h"
 
+#include "core/gfx/FrameDamage.h"
+
 #include <cstdint>
 #include <cstdlib>
 
@@ -12,8 +14,11 @@ public:
 
     void init();
 
+    // only sends the regions that changed since the previous frame
     void draw(uint8_t *frameBuffer);
 
+    void handleIrq();
+
 private:
     void sendCmd(uint8_t cmd);
     void sendData(uint8_t data);
@@ -24,5 +29,14 @@ private:
     void setRowAddr(uint8_t a, uint8_t b);
     void setWrite();
 
+    void startWindow();
+    void startTransfer();
+
+    // SSD1322 column addresses cover 4 pixels (2 bytes)
+    typedef FrameDamage<Width, Height, 2, 8> Damage;
+
     uint32_t _frameBuffer[Width * Height / 8];
+    Damage _damage;
+    int _windowIndex;
+    int _row;
 };
@@ -38,16 +38,30 @@ void Midi::init() {
 }
 
 bool Midi::send(const MidiMessage &message) {
-    for (uint8_t i = 0; i < message.length(); ++i) {
-        send(message.raw()[i]);
+    // messages are sent from the engine and ui task as well as from the clock timer interrupt,
+    // serialize them to keep a single producer
+    os::InterruptLock lock;
+
+    // block until there is space for the whole message, the tx interrupt cannot run so drain the queue directly
+    while (_txQueue.writable() < message.length()) {
+        uint8_t data;
+        _txQueue.read(data);
+        usart_wait_send_ready(MIDI_USART);
+        usart_send(MIDI_USART, data);
     }
 
+    _txQueue.write(message.raw(), message.length());
+
+    // the tx interrupt drains the queue and disables itself when done
+    usart_enable_tx_interrupt(MIDI_USART);
+
     return true;
 }
 
 bool Midi::recv(MidiMessage *message) {
-    while (!_rxBuffer.empty()) {
-        if (_midiParser.feed(_rxBuffer.read())) {
+    uint8_t data;
+    while (_rxQueue.read(data)) {
+        if (_midiParser.feed(data)) {
             *message = _midiParser.message();
             return true;
         }
@@ -59,44 +73,20 @@ void Midi::setRecvFilter(RecvFilter filter) {
     _recvFilter = filter;
 }
 
-void Midi::send(uint8_t data) {
-    os::InterruptLock lock;
-
-    // block until there is space in the tx buffer
-    while (_txBuffer.full()) {
-        usart_wait_send_ready(MIDI_USART);
-        usart_send(MIDI_USART, _txBuffer.read());
-    }
-
-    _txBuffer.write(data);
-
-    // start transmission if necessary
-    if (!_txActive) {
-        _txActive = 1;
-        usart_wait_send_ready(MIDI_USART);
-        usart_send(MIDI_USART, _txBuffer.read());
-        usart_enable_tx_interrupt(MIDI_USART);
-    }
-}
-
 void Midi::handleIrq() {
-    os::InterruptLock lock;
     if (usart_get_flag(MIDI_USART, USART_SR_TXE)) {
-        if (_txBuffer.empty()) {
-            usart_disable_tx_interrupt(MIDI_USART);
-            _txActive = 0;
+        uint8_t data;
+        if (_txQueue.read(data)) {
+            usart_send(MIDI_USART, data);
         } else {
-            usart_send(MIDI_USART, _txBuffer.read());
+            usart_disable_tx_interrupt(MIDI_USART);
         }
     }
     if (usart_get_flag(MIDI_USART, USART_SR_RXNE)) {
         uint8_t data = usart_recv(MIDI_USART);
         if (!_recvFilter || !_recvFilter(data)) {
-            if (_rxBuffer.full()) {
-                // overflow
-                ++_rxOverflow;
-            }
-            _rxBuffer.write(data);
+            // drops and counts the byte if the queue is full
+            _rxQueue.write(data);
         }
     }
 }
@@ -2,7 +2,7 @@
 
 #include "core/midi/MidiMessage.h"
 #include "core/midi/MidiParser.h"
-#include "core/utils/RingBuffer.h"
+#include "core/utils/SpscQueue.h"
 
 #include <functional>
 
@@ -19,16 +19,12 @@ public:
 
     void setRecvFilter(RecvFilter filter);
 
-    uint32_t rxOverflow() const { return _rxOverflow; }
+    uint32_t rxOverflow() const { return _rxQueue.dropped(); }
 
     void handleIrq();
 private:
-    void send(uint8_t data);
-
-    RingBuffer<uint8_t, 64> _txBuffer;
-    RingBuffer<uint8_t, 64> _rxBuffer;
-    volatile uint32_t _rxOverflow = 0;
-    volatile uint32_t _txActive = 0;
+    SpscQueue<uint8_t, 64> _txQueue;
+    SpscQueue<uint8_t, 64> _rxQueue;
 
     RecvFilter _recvFilter;
     MidiParser _midiParser;
@@ -0,0 +1,57 @@
+#include "OutputTimer.h"
+
+#include "SystemConfig.h"
+
+#include "os/os.h"
+
+#include <libopencm3/stm32/rcc.h>
+#include <libopencm3/stm32/timer.h>
+#include <libopencm3/cm3/nvic.h>
+
+#include <algorithm>
+
+#define TIMER TIM3
+
+static OutputTimer::Listener *g_listener;
+
+void OutputTimer::init() {
+    rcc_periph_clock_enable(RCC_TIM3);
+    nvic_set_priority(NVIC_TIM3_IRQ, CONFIG_OUTPUTTIMER_IRQ_PRIORITY);
+    nvic_enable_irq(NVIC_TIM3_IRQ);
+    rcc_periph_reset_pulse(RST_TIM3);
+
+    timer_disable_preload(TIMER);
+    timer_one_shot_mode(TIMER);
+
+    // set to 1mhz
+    uint32_t prescaler = (rcc_apb1_frequency * 2) / 1000000 - 1;
+    timer_set_prescaler(TIMER, prescaler);
+
+    // load the prescaler
+    timer_generate_event(TIMER, TIM_EGR_UG);
+    timer_clear_flag(TIMER, TIM_SR_UIF);
+
+    timer_enable_irq(TIMER, TIM_DIER_UIE);
+}
+
+void OutputTimer::schedule(uint32_t us) {
+    // timer is 16-bit, firing early is fine as the listener reschedules
+    timer_disable_counter(TIMER);
+    timer_set_period(TIMER, std::max(uint32_t(1), std::min(us, uint32_t(0xffff))));
+    timer_set_counter(TIMER, 0);
+    timer_enable_counter(TIMER);
+}
+
+void OutputTimer::setListener(Listener *listener) {
+    os::InterruptLock lock;
+    g_listener = listener;
+}
+
+void tim3_isr() {
+    if (timer_get_flag(TIMER, TIM_SR_UIF)) {
+        timer_clear_flag(TIMER, TIM_SR_UIF);
+        if (g_listener) {
+            g_listener->onOutputTimer();
+        }
+    }
+}
@@ -0,0 +1,18 @@
+#pragma once
+
+#include <cstdint>
+
+// One-shot timer used to apply scheduled outputs at microsecond resolution.
+class OutputTimer {
+public:
+    struct Listener {
+        virtual void onOutputTimer() = 0;
+    };
+
+    void init();
+
+    // fires the listener once after the given number of microseconds (at most 65535)
+    void schedule(uint32_t us);
+
+    void setListener(Listener *listener);
+};
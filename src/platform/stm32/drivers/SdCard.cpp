@@ -57,26 +57,12 @@ bool SdCard::writeProtected() {
 
 bool SdCard::read(uint8_t *buf, uint32_t sector, uint8_t count) {
     // DBG("read(sector=%d,count=%d)", sector, count);
-    uint8_t *data = buf;
-    for (uint32_t i = 0; i < count; ++i) {
-        if (!readBlock(sector + i, data)) {
-            return false;
-        }
-        data += 512;
-    }
-    return true;
+    return count == 0 || readBlocks(sector, buf, count);
 }
 
 bool SdCard::write(const uint8_t *buf, uint32_t sector, uint8_t count) {
     // DBG("write(sector=%d,count=%d)", sector, count);
-    const uint8_t *data = buf;
-    for (uint32_t i = 0; i < count; ++i) {
-        if (!writeBlock(sector + i, data)) {
-            return false;
-        }
-        data += 512;
-    }
-    return true;
+    return count == 0 || writeBlocks(sector, buf, count);
 }
 
 bool SdCard::cardDetect() const {
@@ -307,57 +293,81 @@ bool SdCard::waitDataReady() {
     return false;
 }
 
-bool SdCard::readBlock(uint32_t address, void *buffer) {
-    ASSERT(buffer >= (void *)0x20000000, "buffer not in SRAM");
-    // DBG("readBlock(address=%lu, buffer=%p)", address, buffer);
-    if (!waitDataReady()) {
-        return false;
-    }
-
-    if (!_cardInfo.ccs) {
-        address *= 512;
-        if (sendCommandRetry(16, 512) != Success) {
-            return false;
-        }
-    }
-
-    SDIO_DCTRL = 0;
-
-#if 1
+void SdCard::setupDma(const void *buffer, uint32_t direction) {
     dma_stream_reset(DMA2, DMA_STREAM3);
     dma_channel_select(DMA2, DMA_STREAM3, DMA_SxCR_CHSEL_4);
     dma_set_memory_size(DMA2, DMA_STREAM3, DMA_SxCR_MSIZE_32BIT);
     dma_set_peripheral_size(DMA2, DMA_STREAM3, DMA_SxCR_PSIZE_32BIT);
     dma_enable_memory_increment_mode(DMA2, DMA_STREAM3);
     dma_disable_peripheral_increment_mode(DMA2, DMA_STREAM3);
-    dma_set_transfer_mode(DMA2, DMA_STREAM3, DMA_SxCR_DIR_PERIPHERAL_TO_MEM);
+    dma_set_transfer_mode(DMA2, DMA_STREAM3, direction);
     dma_set_peripheral_address(DMA2, DMA_STREAM3, (uint32_t)&SDIO_FIFO);
     dma_set_memory_address(DMA2, DMA_STREAM3, (uint32_t)buffer);
     dma_set_number_of_data(DMA2, DMA_STREAM3, 0);
     dma_set_priority(DMA2, DMA_STREAM3, DMA_SxCR_PL_VERY_HIGH);
-    // dma_set_peripheral_flow_control(DMA2, DMA_STREAM3);
 
     dma_set_memory_burst(DMA2, DMA_STREAM3, DMA_SxCR_MBURST_INCR4);
     dma_set_peripheral_burst(DMA2, DMA_STREAM3, DMA_SxCR_PBURST_INCR4);
     dma_disable_double_buffer_mode(DMA2, DMA_STREAM3);
-    // dma_enable_circular_mode(DMA2, DMA_STREAM3);
 
     dma_enable_fifo_mode(DMA2, DMA_STREAM3);
     dma_set_fifo_threshold(DMA2, DMA_STREAM3, DMA_SxFCR_FTH_4_4_FULL);
+    // sdio controls the transfer length
     dma_set_peripheral_flow_control(DMA2, DMA_STREAM3);
 
     dma_enable_stream(DMA2, DMA_STREAM3);
-#endif
+}
+
+bool SdCard::waitDataTransfer(uint32_t errorFlags, uint32_t successFlags) {
+    while (!dma_get_interrupt_flag(DMA2, DMA_STREAM3, DMA_TCIF)) {
+        // allow other tasks to run
+        os::this_task::yield();
+    }
+
+    while (true) {
+        volatile uint32_t result = SDIO_STA;
+        // DBG("STA = 0x%x", result);
+        // DBG("FIFOCNT = %d", SDIO_FIFOCNT);
+        if (result & errorFlags) {
+            return false;
+        } else if (result & successFlags) {
+            return true;
+        }
+
+        // allow other tasks to run
+        os::this_task::yield();
+    }
+}
+
+bool SdCard::readBlocks(uint32_t address, void *buffer, uint32_t count) {
+    ASSERT(buffer >= (void *)0x20000000, "buffer not in SRAM");
+    // DBG("readBlocks(address=%lu, buffer=%p, count=%lu)", address, buffer, count);
+    if (!waitDataReady()) {
+        return false;
+    }
+
+    if (!_cardInfo.ccs) {
+        address *= 512;
+        if (sendCommandRetry(16, 512) != Success) {
+            return false;
+        }
+    }
+
+    SDIO_DCTRL = 0;
+
+    setupDma(buffer, DMA_SxCR_DIR_PERIPHERAL_TO_MEM);
 
     // A 100ms timeout expressed as ticks in the 24Mhz bus clock.
     SDIO_DTIMER = 2400000;
 
     // These two registers must be set before SDIO_DCTRL.
-    SDIO_DLEN = 512;
+    SDIO_DLEN = 512 * count;
     SDIO_DCTRL = SDIO_DCTRL_DBLOCKSIZE_9 | SDIO_DCTRL_DMAEN |
                  SDIO_DCTRL_DTDIR | SDIO_DCTRL_DTEN;
 
-    if (sendCommandWait(17, address) != Success) {
+    // single block (CMD17) or multiple blocks (CMD18) read
+    bool multiple = count > 1;
+    if (sendCommandWait(multiple ? 18 : 17, address) != Success) {
         return false;
     }
 
@@ -365,36 +375,22 @@ bool SdCard::readBlock(uint32_t address, void *buffer) {
                                           SDIO_STA_RXOVERR |
                                           SDIO_STA_DTIMEOUT |
                                           SDIO_STA_DCRCFAIL);
-    const uint32_t DATA_RX_SUCCESS_FLAGS = (SDIO_STA_DBCKEND |
-                                            SDIO_STA_DATAEND);
-
-    while (!dma_get_interrupt_flag(DMA2, DMA_STREAM3, DMA_TCIF)) {
-        // allow other tasks to run
-        os::this_task::yield();
-    }
+    // DBCKEND is set after every block, only DATAEND marks the end of a multiple block transfer
+    const uint32_t DATA_RX_SUCCESS_FLAGS = multiple ? SDIO_STA_DATAEND : (SDIO_STA_DBCKEND | SDIO_STA_DATAEND);
 
-    while (true) {
-        volatile uint32_t result = SDIO_STA;
-        // DBG("STA = 0x%x", result);
-        // DBG("FIFOCNT = %d", SDIO_FIFOCNT);
-        if (result & (DATA_RX_SUCCESS_FLAGS | DATA_RX_ERROR_FLAGS)) {
-            if (result & DATA_RX_ERROR_FLAGS) {
-                return false;
-            } else if (result & DATA_RX_SUCCESS_FLAGS) {
-                break;
-            }
-        }
+    bool success = waitDataTransfer(DATA_RX_ERROR_FLAGS, DATA_RX_SUCCESS_FLAGS);
 
-        // allow other tasks to run
-        os::this_task::yield();
+    // stop transmission
+    if (multiple && sendCommandWait(12, 0) != Success) {
+        return false;
     }
 
-    return true;
+    return success;
 }
 
-bool SdCard::writeBlock(uint32_t address, const void *buffer) {
+bool SdCard::writeBlocks(uint32_t address, const void *buffer, uint32_t count) {
     ASSERT(buffer >= (void *)0x20000000, "buffer not in SRAM");
-    // DBG("writeBlock(address=%lu, buffer=%p)", address, buffer);
+    // DBG("writeBlocks(address=%lu, buffer=%p, count=%lu)", address, buffer, count);
     if (!waitDataReady()) {
         return false;
     }
@@ -406,71 +402,40 @@ bool SdCard::writeBlock(uint32_t address, const void *buffer) {
         }
     }
 
-    if (sendCommandWait(24, address) != Success) {
+    bool multiple = count > 1;
+    if (multiple) {
+        // let the card pre-erase the blocks (ACMD23), speeds up the following write
+        sendAppCommand(23, count);
+    }
+
+    // single block (CMD24) or multiple blocks (CMD25) write
+    if (sendCommandWait(multiple ? 25 : 24, address) != Success) {
         return false;
     }
 
     SDIO_DCTRL = 0;
 
-#if 1
-    dma_stream_reset(DMA2, DMA_STREAM3);
-    dma_channel_select(DMA2, DMA_STREAM3, DMA_SxCR_CHSEL_4);
-    dma_set_memory_size(DMA2, DMA_STREAM3, DMA_SxCR_MSIZE_32BIT);
-    dma_set_peripheral_size(DMA2, DMA_STREAM3, DMA_SxCR_PSIZE_32BIT);
-    dma_enable_memory_increment_mode(DMA2, DMA_STREAM3);
-    dma_disable_peripheral_increment_mode(DMA2, DMA_STREAM3);
-    dma_set_transfer_mode(DMA2, DMA_STREAM3, DMA_SxCR_DIR_MEM_TO_PERIPHERAL);
-    dma_set_peripheral_address(DMA2, DMA_STREAM3, (uint32_t)&SDIO_FIFO);
-    dma_set_memory_address(DMA2, DMA_STREAM3, (uint32_t)buffer);
-    dma_set_number_of_data(DMA2, DMA_STREAM3, 0);
-    dma_set_priority(DMA2, DMA_STREAM3, DMA_SxCR_PL_VERY_HIGH);
-    // dma_set_peripheral_flow_control(DMA2, DMA_STREAM3);
-
-    dma_set_memory_burst(DMA2, DMA_STREAM3, DMA_SxCR_MBURST_INCR4);
-    dma_set_peripheral_burst(DMA2, DMA_STREAM3, DMA_SxCR_PBURST_INCR4);
-    dma_disable_double_buffer_mode(DMA2, DMA_STREAM3);
-    // dma_enable_circular_mode(DMA2, DMA_STREAM3);
-
-    dma_enable_fifo_mode(DMA2, DMA_STREAM3);
-    dma_set_fifo_threshold(DMA2, DMA_STREAM3, DMA_SxFCR_FTH_4_4_FULL);
-    dma_set_peripheral_flow_control(DMA2, DMA_STREAM3);
-
-    dma_enable_stream(DMA2, DMA_STREAM3);
-#endif
+    setupDma(buffer, DMA_SxCR_DIR_MEM_TO_PERIPHERAL);
 
     // A 500ms timeout expressed as ticks in the 24Mhz bus clock.
     SDIO_DTIMER = 12000000;
     // These two registers must be set before SDIO_DCTRL.
-    SDIO_DLEN = 512;
+    SDIO_DLEN = 512 * count;
     SDIO_DCTRL = SDIO_DCTRL_DBLOCKSIZE_9 | SDIO_DCTRL_DMAEN | SDIO_DCTRL_DTEN;
 
     const uint32_t DATA_TX_ERROR_FLAGS = (SDIO_STA_STBITERR |
                                           SDIO_STA_TXUNDERR |
                                           SDIO_STA_DTIMEOUT |
                                           SDIO_STA_DCRCFAIL);
-    const uint32_t DATA_TX_SUCCESS_FLAGS = (SDIO_STA_DBCKEND |
-                                            SDIO_STA_DATAEND);
+    // DBCKEND is set after every block, only DATAEND marks the end of a multiple block transfer
+    const uint32_t DATA_TX_SUCCESS_FLAGS = multiple ? SDIO_STA_DATAEND : (SDIO_STA_DBCKEND | SDIO_STA_DATAEND);
 
-    while (!dma_get_interrupt_flag(DMA2, DMA_STREAM3, DMA_TCIF)) {
-        // allow other tasks to run
-        os::this_task::yield();
-    }
+    bool success = waitDataTransfer(DATA_TX_ERROR_FLAGS, DATA_TX_SUCCESS_FLAGS);
 
-    while (true) {
-        volatile uint32_t result = SDIO_STA;
-        // DBG("STA = 0x%x", result);
-        // DBG("FIFOCNT = %d", SDIO_FIFOCNT);
-        if (result & (DATA_TX_SUCCESS_FLAGS | DATA_TX_ERROR_FLAGS)) {
-            if (result & DATA_TX_ERROR_FLAGS) {
-                return false;
-            } else if (result & DATA_TX_SUCCESS_FLAGS) {
-                break;
-            }
-        }
-
-        // allow other tasks to run
-        os::this_task::yield();
+    // stop transmission, the card signals busy while programming which is handled by waitDataReady()
+    if (multiple && sendCommandWait(12, 0) != Success) {
+        return false;
     }
 
-    return true;
+    return success;
 }
@@ -55,8 +55,11 @@ private:
     bool initCard();
     bool waitDataReady();
 
-    bool readBlock(uint32_t address, void *buffer);
-    bool writeBlock(uint32_t address, const void *buffer);
+    void setupDma(const void *buffer, uint32_t direction);
+    bool waitDataTransfer(uint32_t errorFlags, uint32_t successFlags);
+
+    bool readBlocks(uint32_t address, void *buffer, uint32_t count);
+    bool writeBlocks(uint32_t address, const void *buffer, uint32_t count);
 
     bool _initialized = false;
     CardInfo _cardInfo;
@@ -5,6 +5,8 @@
 #include "core/profiler/Profiler.h"
 #include "core/Debug.h"
 
+#include "os/os.h"
+
 #include <libopencm3/stm32/gpio.h>
 #include <libopencm3/stm32/rcc.h>
 #include <libopencm3/stm32/spi.h>
@@ -29,6 +31,7 @@
 
 ShiftRegister::ShiftRegister() {
     _outputs.fill(0u);
+    _latched.fill(0u);
     _inputs.fill(0u);
 }
 
@@ -66,13 +69,33 @@ void ShiftRegister::init() {
 }
 
 void ShiftRegister::process() {
+    // locked against writeImmediate() called from the output timer interrupt (see GateOutput)
+    os::InterruptLock lock;
+
     // trigger load line
     gpio_clear(SR_PORT, SR_LOAD);
     gpio_set(SR_PORT, SR_LOAD);
 
     // transfer data
+    _latched = _outputs;
+    for (int sr = 0; sr < NumRegisters; ++sr) {
+        _inputs[sr] = spi_xfer(SR_SPI, _latched[NumRegisters - sr - 1]);
+    }
+
+    // trigger latch line
+    gpio_set(SR_PORT, SR_LATCH);
+    gpio_clear(SR_PORT, SR_LATCH);
+}
+
+void ShiftRegister::writeImmediate(int index, uint8_t value) {
+    os::InterruptLock lock;
+
+    _outputs[index] = value;
+    _latched[index] = value;
+
+    // transfer data (without load, the input registers are reloaded by the next process() call)
     for (int sr = 0; sr < NumRegisters; ++sr) {
-        _inputs[sr] = spi_xfer(SR_SPI, _outputs[NumRegisters - sr - 1]);
+        spi_xfer(SR_SPI, _latched[NumRegisters - sr - 1]);
     }
 
     // trigger latch line
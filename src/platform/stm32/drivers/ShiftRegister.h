@@ -16,10 +16,16 @@ public:
 
     void process();
 
+    // writes a single output register and shifts out right away without loading the inputs,
+    // the other registers keep the values shifted out by the last process() call so the
+    // button matrix scan is not affected
+    void writeImmediate(int index, uint8_t value);
+
     uint8_t read(int index) const { return _inputs[index]; }
     void write(int index, uint8_t value) { _outputs[index] = value; }
 
 private:
     std::array<uint8_t, NumRegisters> _outputs;
+    std::array<uint8_t, NumRegisters> _latched;
     std::array<uint8_t, NumRegisters> _inputs;
 };
@@ -1,8 +1,10 @@
 #pragma once
 
-#include "core/utils/RingBuffer.h"
+#include "core/utils/SpscQueue.h"
 #include "core/midi/MidiMessage.h"
 
+#include "os/os.h"
+
 #include <functional>
 
 #include <cstdint>
@@ -16,18 +18,16 @@ public:
     void init() {}
 
     bool send(uint8_t cable, const MidiMessage &message) {
-        if (_txQueue.full()) {
-            return false;
-        }
-        _txQueue.write({ cable, message });
-        return true;
+        // engine and ui task both send messages, serialize them to keep the single producer
+        os::InterruptLock lock;
+        return _txQueue.write({ cable, message });
     }
 
     bool recv(uint8_t *cable, MidiMessage *message) {
-        if (_rxQueue.empty()) {
+        CableAndMessage cableAndMessage;
+        if (!_rxQueue.readAndReplace(cableAndMessage)) {
             return false;
         }
-        auto cableAndMessage = _rxQueue.read();
         *cable = cableAndMessage.cable;
         *message = cableAndMessage.message;
         return true;
@@ -45,7 +45,11 @@ public:
         _recvFilter = filter;
     }
 
-    uint32_t rxOverflow() const { return 0; }
+    uint32_t rxOverflow() const { return _rxQueue.dropped(); }
+    uint32_t txOverflow() const { return _txQueue.dropped(); }
+
+    // number of messages that can be sent without overflowing the transmit queue
+    uint32_t txAvailable() const { return _txQueue.writable(); }
 
 private:
     void connect(uint16_t vendorId, uint16_t productId) {
@@ -61,10 +65,7 @@ private:
     }
 
     void enqueueMessage(uint8_t cable, const MidiMessage &message) {
-        if (_rxQueue.full()) {
-            // overflow
-            ++_rxOverflow;
-        }
+        // drops and counts the message if the queue is full
         _rxQueue.write({ cable, message });
     }
 
@@ -75,12 +76,12 @@ private:
     }
 
     bool dequeueMessage(uint8_t *cable, MidiMessage *message) {
-        if (_txQueue.empty()) {
+        CableAndMessage cableAndMessage;
+        if (!_txQueue.readAndReplace(cableAndMessage)) {
             return false;
         }
-        auto messageAndCable = _txQueue.readAndReplace();
-        *cable = messageAndCable.cable;
-        *message = messageAndCable.message;
+        *cable = cableAndMessage.cable;
+        *message = cableAndMessage.message;
         return true;
     }
 
@@ -93,9 +94,8 @@ private:
         MidiMessage message;
     };
 
-    RingBuffer<CableAndMessage, 128> _txQueue;
-    RingBuffer<CableAndMessage, 16> _rxQueue;
-    volatile uint32_t _rxOverflow = 0;
+    SpscQueue<CableAndMessage, 128> _txQueue;
+    SpscQueue<CableAndMessage, 16> _rxQueue;
 
     friend class UsbH;
 };
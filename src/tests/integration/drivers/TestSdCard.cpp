@@ -28,12 +28,21 @@ public:
             return;
         }
 
+        // single and multiple block transfers
+        testTransfer(1);
+        testTransfer(8);
+        testTransfer(64);
+    }
+
+    void testTransfer(uint32_t sectorCount) {
         static constexpr uint32_t Runs = 32;
-        static constexpr uint32_t SectorCount = 1;
-        static constexpr uint32_t DataLength = SectorCount * 512;
+        static constexpr uint32_t MaxSectorCount = 64;
+        static constexpr uint32_t MaxDataLength = MaxSectorCount * 512;
+
+        static uint8_t data[MaxDataLength];
+        static uint8_t buf[MaxDataLength];
 
-        static uint8_t data[DataLength];
-        static uint8_t buf[DataLength];
+        uint32_t dataLength = sectorCount * 512;
 
         Random rng;
 
@@ -44,13 +53,13 @@ public:
 
         for (size_t run = 0; run < Runs; ++run) {
             // create random data
-            for (size_t i = 0; i < DataLength; ++i) {
+            for (size_t i = 0; i < dataLength; ++i) {
                 data[i] = (rng.next() >> (i % 24)) & 0xff;
             }
 
             // write data
             timer.reset();
-            if (!sdCard.write(data, 0, SectorCount)) {
+            if (!sdCard.write(data, 0, sectorCount)) {
                 DBG("write failed");
             }
             writeTime += timer.elapsed();
@@ -59,14 +68,14 @@ public:
 
             // read data
             timer.reset();
-            if (!sdCard.read(buf, 0, SectorCount)) {
+            if (!sdCard.read(buf, 0, sectorCount)) {
                 DBG("read failed");
             }
             readTime += timer.elapsed();
 
             // verify data
             bool success = true;
-            for (size_t i = 0; i < DataLength; ++i) {
+            for (size_t i = 0; i < dataLength; ++i) {
                 if (buf[i] != data[i]) {
                     DBG("Verify failed: buf[%zd] = %02x, data[%zd] = %02x", i, buf[i], i, data[i]);
                     success = false;
@@ -77,8 +86,9 @@ public:
         }
 
         // report throughput
-        DBG("Write throughput: %.1f kB/s", (DataLength / 1024.0) * 1000000.0 / writeTime);
-        DBG("Read throughput: %.1f kB/s", (DataLength / 1024.0) * 1000000.0 / readTime);
+        DBG("%d sectors per transfer", int(sectorCount));
+        DBG("Write throughput: %.1f kB/s", (Runs * dataLength / 1024.0) * 1000000.0 / writeTime);
+        DBG("Read throughput: %.1f kB/s", (Runs * dataLength / 1024.0) * 1000000.0 / readTime);
     }
 
 private:
@@ -13,6 +13,11 @@
 
 Random rng;
 
+// data buffers shared by all tests
+static constexpr size_t DataLength = 16*1024;
+static uint8_t data[DataLength];
+static uint8_t buf[DataLength];
+
 class FileSystemTest : public IntegrationTest {
 public:
     FileSystemTest() :
@@ -27,6 +32,7 @@ public:
         // testFileWriteRead();
         // testDirectoryList();
         testFileWriterReader();
+        testThroughput();
     }
 
     void fsAssert(fs::Error actual, fs::Error expected, const char *msg) {
@@ -53,10 +59,6 @@ public:
 
     void testFileWriteRead() {
         test("File write/read/stat/delete", [this] () {
-            static constexpr size_t DataLength = 16*1024;
-            static uint8_t data[DataLength];
-            static uint8_t buf[DataLength];
-
             const char *filename = "test.dat";
 
             // create random data
@@ -151,6 +153,76 @@ public:
         });
     }
 
+    // writes and reads files the way the file manager does (small chunks through FileWriter/FileReader)
+    // and with large transfers, reports throughput and sector cache efficiency
+    void testThroughput() {
+        test("Throughput", [this] () {
+            static constexpr size_t ChunkLength = 16;
+            static constexpr int Files = 16;
+
+            for (size_t i = 0; i < DataLength; ++i) {
+                data[i] = rng.next() & 0xff;
+            }
+
+            const auto &cache = volume.sectorCache();
+            Timer timer;
+
+            auto report = [&] (const char *name, uint32_t hits, uint32_t misses) {
+                uint32_t time = timer.elapsed();
+                DBG("%s: %.1f kB/s (cache hits = %d, misses = %d)", name,
+                    (Files * DataLength / 1024.0) * 1000000.0 / time,
+                    int(cache.hits() - hits), int(cache.misses() - misses)
+                );
+            };
+
+            uint32_t hits = cache.hits();
+            uint32_t misses = cache.misses();
+            timer.reset();
+            for (int i = 0; i < Files; ++i) {
+                fs::FileWriter writer(FixedStringBuilder<8>("%d.pro", i));
+                for (size_t offset = 0; offset < DataLength; offset += ChunkLength) {
+                    fsAssert(writer.write(data + offset, ChunkLength), fs::OK, "failed to write");
+                }
+                fsAssert(writer.finish(), fs::OK, "failed to finish writing");
+            }
+            report("FileWriter", hits, misses);
+
+            hits = cache.hits();
+            misses = cache.misses();
+            timer.reset();
+            for (int i = 0; i < Files; ++i) {
+                fs::FileReader reader(FixedStringBuilder<8>("%d.pro", i));
+                for (size_t offset = 0; offset < DataLength; offset += ChunkLength) {
+                    fsAssert(reader.read(buf + offset, ChunkLength), fs::OK, "failed to read");
+                }
+                fsAssert(reader.finish(), fs::OK, "failed to finish reading");
+                EXPECT(std::memcmp(buf, data, DataLength) == 0, "read invalid data");
+            }
+            report("FileReader", hits, misses);
+
+            hits = cache.hits();
+            misses = cache.misses();
+            timer.reset();
+            fs::File file;
+            for (int i = 0; i < Files; ++i) {
+                fsAssert(file.open(FixedStringBuilder<8>("%d.dat", i), fs::File::Write), fs::OK, "failed to open file for writing");
+                fsAssert(file.write(data, DataLength), fs::OK, "failed to write to file");
+                fsAssert(file.close(), fs::OK, "failed to close file after writing");
+            }
+            report("File write", hits, misses);
+
+            hits = cache.hits();
+            misses = cache.misses();
+            timer.reset();
+            for (int i = 0; i < Files; ++i) {
+                fsAssert(file.open(FixedStringBuilder<8>("%d.dat", i), fs::File::Read), fs::OK, "failed to open file for reading");
+                fsAssert(file.read(buf, DataLength), fs::OK, "failed to read from file");
+                fsAssert(file.close(), fs::OK, "failed to close file after reading");
+                EXPECT(std::memcmp(buf, data, DataLength) == 0, "read invalid data");
+            }
+            report("File read", hits, misses);
+        });
+    }
 
 private:
     SdCard sdCard;
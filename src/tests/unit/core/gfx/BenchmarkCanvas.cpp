@@ -0,0 +1,79 @@
+#include "ReferenceCanvas.h"
+
+#include "core/gfx/Canvas.h"
+#include "core/gfx/fonts/tiny5x5.h"
+
+#include <chrono>
+#include <functional>
+
+#include <cstdint>
+#include <cstdio>
+
+// Canvas micro-benchmark.
+// Compares the optimized canvas primitives with the pixel by pixel reference implementation on the host.
+
+static constexpr int Width = 256;
+static constexpr int Height = 64;
+static constexpr int Iterations = 2000;
+
+static uint8_t data[Width * Height];
+static FrameBuffer8bit frameBuffer(Width, Height, data);
+static float brightness = 1.f;
+static Canvas canvas(frameBuffer, brightness);
+
+static double measure(std::function<void()> func) {
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < Iterations; ++i) {
+        func();
+    }
+    return std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start).count() * 1e6 / Iterations;
+}
+
+static void compare(const char *name, std::function<void()> referenceFunc, std::function<void()> canvasFunc) {
+    double referenceUs = measure(referenceFunc);
+    double canvasUs = measure(canvasFunc);
+    std::printf("%-24s %10.2f %10.2f %8.2fx\n", name, referenceUs, canvasUs, referenceUs / canvasUs);
+}
+
+int main() {
+    const char *text = "NOTE SEQUENCE EDIT 0123456789";
+    const BlendMode blendModes[] = { BlendMode::Set, BlendMode::Add, BlendMode::Sub };
+    const char *blendModeNames[] = { "set", "add", "sub" };
+
+    std::printf("%-24s %10s %10s %9s\n", "primitive (us/frame)", "reference", "canvas", "speedup");
+
+    for (int i = 0; i < 3; ++i) {
+        auto blendMode = blendModes[i];
+        canvas.setBlendMode(blendMode);
+        canvas.setColor(Color::Medium);
+        uint8_t color = canvas.color();
+        char name[32];
+
+        std::snprintf(name, sizeof(name), "fill %s", blendModeNames[i]);
+        compare(name,
+            [&] () { reference::fillRect(frameBuffer, 0, 0, Width, Height, color, blendMode); },
+            [&] () { canvas.fillRect(0, 0, Width, Height); }
+        );
+
+        std::snprintf(name, sizeof(name), "hline x64 %s", blendModeNames[i]);
+        compare(name,
+            [&] () { for (int y = 0; y < Height; ++y) reference::hline(frameBuffer, y, y, 200, color, blendMode); },
+            [&] () { for (int y = 0; y < Height; ++y) canvas.hline(y, y, 200); }
+        );
+
+        std::snprintf(name, sizeof(name), "fillRect x64 %s", blendModeNames[i]);
+        compare(name,
+            [&] () { for (int j = 0; j < 64; ++j) reference::fillRect(frameBuffer, (j % 16) * 16 + 1, (j / 16) * 16 + 1, 13, 13, color, blendMode); },
+            [&] () { for (int j = 0; j < 64; ++j) canvas.fillRect((j % 16) * 16 + 1, (j / 16) * 16 + 1, 13, 13); }
+        );
+
+        std::snprintf(name, sizeof(name), "text x8 %s", blendModeNames[i]);
+        canvas.setFont(Font::Tiny);
+        compare(name,
+            [&] () { for (int y = 0; y < 8; ++y) reference::drawText(frameBuffer, tiny5x5, 2, y * 8 + 6, text, color, blendMode); },
+            [&] () { for (int y = 0; y < 8; ++y) canvas.drawText(2, y * 8 + 6, text); }
+        );
+    }
+
+    return 0;
+}
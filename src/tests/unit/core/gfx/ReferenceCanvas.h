@@ -0,0 +1,65 @@
+#pragma once
+
+#include "core/gfx/Canvas.h"
+#include "core/gfx/fonts/BitmapFont.h"
+
+#include <algorithm>
+
+#include <cstdint>
+
+// Reference implementation of the canvas primitives drawing pixel by pixel.
+// Used to verify and benchmark the optimized drawing paths in Canvas.
+namespace reference {
+
+    static inline void blend(uint8_t &dst, uint8_t color, BlendMode blendMode) {
+        switch (blendMode) {
+        case BlendMode::Set: dst = color; break;
+        case BlendMode::Add: dst += color; break;
+        case BlendMode::Sub: dst -= std::min(dst, color); break;
+        }
+    }
+
+    static void fillRect(FrameBuffer8bit &frameBuffer, int x, int y, int w, int h, uint8_t color, BlendMode blendMode) {
+        int right = frameBuffer.width() - 1;
+        int bottom = frameBuffer.height() - 1;
+        int x0 = std::max(0, std::min(right, x)), x1 = std::max(0, std::min(right, x + w - 1));
+        int y0 = std::max(0, std::min(bottom, y)), y1 = std::max(0, std::min(bottom, y + h - 1));
+        for (int py = y0; py <= y1; ++py) {
+            for (int px = x0; px <= x1; ++px) {
+                blend(frameBuffer(px, py), color, blendMode);
+            }
+        }
+    }
+
+    static void hline(FrameBuffer8bit &frameBuffer, int x, int y, int w, uint8_t color, BlendMode blendMode) {
+        if (y >= 0 && y < frameBuffer.height()) {
+            fillRect(frameBuffer, x, y, w, 1, color, blendMode);
+        }
+    }
+
+    static void drawText(FrameBuffer8bit &frameBuffer, const BitmapFont &font, int x, int y, const char *str, uint8_t color, BlendMode blendMode) {
+        while (*str != '\0') {
+            auto c = *str++;
+            if (c < font.first || c > font.last) {
+                continue;
+            }
+            const auto &g = font.glyphs[c - font.first];
+            const uint8_t *bitmap = &font.bitmap[g.offset];
+            int shift = 0;
+            for (int py = y + g.yOffset; py < y + g.yOffset + g.height; ++py) {
+                for (int px = x + g.xOffset; px < x + g.xOffset + g.width; ++px) {
+                    uint8_t pixel = ((*bitmap >> shift) & 1) * color;
+                    if (++shift >= 8) {
+                        ++bitmap;
+                        shift = 0;
+                    }
+                    if (px >= 0 && px < frameBuffer.width() && py >= 0 && py < frameBuffer.height()) {
+                        blend(frameBuffer(px, py), pixel, blendMode);
+                    }
+                }
+            }
+            x += g.xAdvance;
+        }
+    }
+
+} // namespace reference
@@ -0,0 +1,99 @@
+#include "UnitTest.h"
+
+#include "ReferenceCanvas.h"
+
+#include "core/gfx/Canvas.h"
+#include "core/gfx/fonts/tiny5x5.h"
+#include "core/gfx/fonts/ati8x8.h"
+#include "core/utils/Random.h"
+
+#include <cstdint>
+#include <cstring>
+
+static constexpr int Width = 256;
+static constexpr int Height = 64;
+
+struct Buffers {
+    uint8_t data[Width * Height];
+    uint8_t referenceData[Width * Height];
+    FrameBuffer8bit frameBuffer;
+    FrameBuffer8bit referenceFrameBuffer;
+    float brightness = 1.f;
+    Canvas canvas;
+
+    Buffers() :
+        frameBuffer(Width, Height, data),
+        referenceFrameBuffer(Width, Height, referenceData),
+        canvas(frameBuffer, brightness)
+    {
+        Random rng(1234);
+        for (int i = 0; i < Width * Height; ++i) {
+            data[i] = referenceData[i] = rng.next() & 0x1f;
+        }
+    }
+
+    bool equal() const {
+        return std::memcmp(data, referenceData, sizeof(data)) == 0;
+    }
+};
+
+static const BlendMode blendModes[] = { BlendMode::Set, BlendMode::Add, BlendMode::Sub };
+
+UNIT_TEST("Canvas") {
+
+    CASE("hline matches reference") {
+        Buffers buffers;
+        for (auto blendMode : blendModes) {
+            buffers.canvas.setBlendMode(blendMode);
+            buffers.canvas.setColor(Color::Medium);
+            for (int x = -5; x < 12; ++x) {
+                for (int w = 0; w < 20; ++w) {
+                    buffers.canvas.hline(x, x + 5, w);
+                    reference::hline(buffers.referenceFrameBuffer, x, x + 5, w, buffers.canvas.color(), blendMode);
+                }
+            }
+            buffers.canvas.hline(250, 3, 20);
+            reference::hline(buffers.referenceFrameBuffer, 250, 3, 20, buffers.canvas.color(), blendMode);
+            expectTrue(buffers.equal());
+        }
+    }
+
+    CASE("fillRect matches reference") {
+        Buffers buffers;
+        Random rng(42);
+        for (auto blendMode : blendModes) {
+            buffers.canvas.setBlendMode(blendMode);
+            for (int i = 0; i < 100; ++i) {
+                int x = int(rng.nextRange(Width + 20)) - 10;
+                int y = int(rng.nextRange(Height + 20)) - 10;
+                int w = rng.nextRange(64);
+                int h = rng.nextRange(32);
+                buffers.canvas.setColorValue(rng.nextRange(16));
+                buffers.canvas.fillRect(x, y, w, h);
+                reference::fillRect(buffers.referenceFrameBuffer, x, y, w, h, buffers.canvas.color(), blendMode);
+            }
+            expectTrue(buffers.equal());
+        }
+    }
+
+    CASE("drawText matches reference") {
+        Buffers buffers;
+        const char *text = "Hello World! 0123456789 {}[] ~";
+        for (auto blendMode : blendModes) {
+            buffers.canvas.setBlendMode(blendMode);
+            buffers.canvas.setColor(Color::Bright);
+            for (int x : { -7, 0, 3, 200 }) {
+                for (int y : { -3, 0, 8, 40, 66 }) {
+                    buffers.canvas.setFont(Font::Tiny);
+                    buffers.canvas.drawText(x, y, text);
+                    reference::drawText(buffers.referenceFrameBuffer, tiny5x5, x, y, text, buffers.canvas.color(), blendMode);
+                    buffers.canvas.setFont(Font::Small);
+                    buffers.canvas.drawText(x, y, text);
+                    reference::drawText(buffers.referenceFrameBuffer, ati8x8, x, y, text, buffers.canvas.color(), blendMode);
+                }
+            }
+            expectTrue(buffers.equal());
+        }
+    }
+
+}
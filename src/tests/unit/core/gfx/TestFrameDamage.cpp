@@ -0,0 +1,106 @@
+#include "UnitTest.h"
+
+#include "core/gfx/FrameDamage.h"
+
+#include <cstdint>
+#include <cstring>
+
+static constexpr int Width = 32;
+static constexpr int Height = 16;
+
+typedef FrameDamage<Width, Height, 2, 4> Damage;
+
+UNIT_TEST("FrameDamage") {
+
+    CASE("first update covers full frame") {
+        Damage damage;
+        uint8_t frame[Width * Height] = {};
+        uint8_t packed[Width * Height / 2] = {};
+        damage.update(frame, packed);
+        expectEqual(damage.windowCount(), 1);
+        expectTrue(damage.window(0).fullWidth());
+        expectEqual(int(damage.window(0).row0), 0);
+        expectEqual(int(damage.window(0).row1), Height - 1);
+        expectEqual(damage.size(), Width * Height / 2);
+    }
+
+    CASE("unchanged frame has no windows") {
+        Damage damage;
+        uint8_t frame[Width * Height] = {};
+        uint8_t packed[Width * Height / 2] = {};
+        damage.update(frame, packed);
+        damage.update(frame, packed);
+        expectEqual(damage.windowCount(), 0);
+        expectEqual(damage.size(), 0);
+    }
+
+    CASE("packs and clamps pixels") {
+        Damage damage;
+        uint8_t frame[Width * Height] = {};
+        uint8_t packed[Width * Height / 2] = {};
+        frame[0] = 0x3;
+        frame[1] = 0xff;
+        damage.update(frame, packed);
+        expectEqual(int(packed[0]), 0x3f);
+    }
+
+    CASE("single pixel change is aligned to columns") {
+        Damage damage;
+        uint8_t frame[Width * Height] = {};
+        uint8_t packed[Width * Height / 2] = {};
+        damage.update(frame, packed);
+        frame[5 * Width + 6] = 0xf; // byte 3 in row 5
+        damage.update(frame, packed);
+        expectEqual(damage.windowCount(), 1);
+        expectEqual(int(damage.window(0).row0), 5);
+        expectEqual(int(damage.window(0).row1), 5);
+        expectEqual(int(damage.window(0).col0), 2);
+        expectEqual(int(damage.window(0).col1), 3);
+        expectEqual(damage.size(), 2);
+    }
+
+    CASE("consecutive rows are grouped") {
+        Damage damage;
+        uint8_t frame[Width * Height] = {};
+        uint8_t packed[Width * Height / 2] = {};
+        damage.update(frame, packed);
+        frame[2 * Width + 0] = 0xf;
+        frame[3 * Width + 10] = 0xf;
+        frame[10 * Width + 20] = 0xf;
+        damage.update(frame, packed);
+        expectEqual(damage.windowCount(), 2);
+        expectEqual(int(damage.window(0).row0), 2);
+        expectEqual(int(damage.window(0).row1), 3);
+        expectEqual(int(damage.window(0).col0), 0);
+        expectEqual(int(damage.window(0).col1), 5);
+        expectEqual(int(damage.window(1).row0), 10);
+        expectEqual(int(damage.window(1).col0), 10);
+        expectEqual(int(damage.window(1).col1), 11);
+    }
+
+    CASE("rows are merged into last window when out of windows") {
+        Damage damage;
+        uint8_t frame[Width * Height] = {};
+        uint8_t packed[Width * Height / 2] = {};
+        damage.update(frame, packed);
+        for (int y = 0; y < Height; y += 2) {
+            frame[y * Width] = 0xf;
+        }
+        damage.update(frame, packed);
+        expectEqual(damage.windowCount(), 4);
+        expectEqual(int(damage.window(3).row0), 6);
+        expectEqual(int(damage.window(3).row1), Height - 2);
+    }
+
+    CASE("invalidate forces full frame") {
+        Damage damage;
+        uint8_t frame[Width * Height] = {};
+        uint8_t packed[Width * Height / 2] = {};
+        damage.update(frame, packed);
+        damage.invalidate();
+        damage.update(frame, packed);
+        expectEqual(damage.windowCount(), 1);
+        expectEqual(damage.size(), Width * Height / 2);
+    }
+
+}
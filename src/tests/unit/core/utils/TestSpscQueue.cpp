@@ -0,0 +1,139 @@
+#include "UnitTest.h"
+
+#include "core/utils/SpscQueue.h"
+
+#include <thread>
+
+UNIT_TEST("SpscQueue") {
+
+    CASE("write/read") {
+        SpscQueue<int, 4> queue;
+
+        expectEqual(queue.size(), size_t(4));
+        expectTrue(queue.empty());
+        expectEqual(queue.writable(), size_t(4));
+
+        for (int i = 0; i < 4; ++i) {
+            expectTrue(queue.write(i));
+            expectEqual(queue.readable(), size_t(i + 1));
+        }
+        expectTrue(queue.full());
+
+        for (int i = 0; i < 4; ++i) {
+            int value = 0;
+            expectTrue(queue.read(value));
+            expectEqual(value, i);
+        }
+        expectTrue(queue.empty());
+
+        int value = 0;
+        expectFalse(queue.read(value));
+        expectEqual(queue.dropped(), uint32_t(0));
+    }
+
+    CASE("peek") {
+        SpscQueue<int, 4> queue;
+
+        int value = 0;
+        expectFalse(queue.peek(value));
+        queue.write(1);
+        queue.write(2);
+        expectTrue(queue.peek(value));
+        expectEqual(value, 1);
+        expectEqual(queue.readable(), size_t(2));
+        expectTrue(queue.read(value));
+        expectTrue(queue.peek(value));
+        expectEqual(value, 2);
+    }
+
+    CASE("overflow") {
+        SpscQueue<int, 4> queue;
+
+        for (int i = 0; i < 6; ++i) {
+            expectEqual(queue.write(i), i < 4);
+        }
+        expectEqual(queue.dropped(), uint32_t(2));
+
+        // oldest items are kept
+        int value = 0;
+        expectTrue(queue.read(value));
+        expectEqual(value, 0);
+        expectTrue(queue.write(6));
+        expectEqual(queue.dropped(), uint32_t(2));
+    }
+
+    CASE("bulk write/read with wrap around") {
+        SpscQueue<int, 8> queue;
+
+        int data[8];
+        int next = 0;
+        int expected = 0;
+        for (int iteration = 0; iteration < 100; ++iteration) {
+            size_t length = 1 + iteration % 5;
+            for (size_t i = 0; i < length; ++i) {
+                data[i] = next + i;
+            }
+            next += queue.write(data, length);
+
+            size_t count = queue.read(data, 1 + (iteration * 3) % 7);
+            for (size_t i = 0; i < count; ++i) {
+                expectEqual(data[i], expected++);
+            }
+        }
+
+        expectEqual(uint32_t(next - expected), uint32_t(queue.readable()));
+    }
+
+    CASE("bulk write drops remaining items") {
+        SpscQueue<int, 4> queue;
+
+        int data[6] = { 0, 1, 2, 3, 4, 5 };
+        expectEqual(queue.write(data, 6), size_t(4));
+        expectEqual(queue.dropped(), uint32_t(2));
+        expectTrue(queue.full());
+    }
+
+    CASE("index wrap around") {
+        SpscQueue<int, 2> queue;
+
+        // run the free running indices through more than one wrap of the mask
+        for (int i = 0; i < 1000; ++i) {
+            int value = 0;
+            expectTrue(queue.write(i));
+            expectTrue(queue.read(value));
+            expectEqual(value, i);
+        }
+    }
+
+    CASE("concurrent producer/consumer") {
+        SpscQueue<uint32_t, 16> queue;
+        const uint32_t count = 20000;
+
+        std::thread producer([&] () {
+            for (uint32_t i = 0; i < count; ++i) {
+                while (!queue.writable()) {
+                    std::this_thread::yield();
+                }
+                queue.write(i);
+            }
+        });
+
+        uint32_t expected = 0;
+        bool ordered = true;
+        while (expected < count) {
+            uint32_t value = 0;
+            if (queue.read(value)) {
+                ordered &= value == expected;
+                ++expected;
+            } else {
+                std::this_thread::yield();
+            }
+        }
+
+        producer.join();
+
+        expectTrue(ordered);
+        expectEqual(queue.dropped(), uint32_t(0));
+    }
+
+}
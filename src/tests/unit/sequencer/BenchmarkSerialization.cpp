@@ -0,0 +1,158 @@
+// model sources first, they use a local CASE macro
+#include "apps/sequencer/model/NoteSequence.cpp"
+#include "apps/sequencer/model/Scale.cpp"
+#include "apps/sequencer/model/UserScale.cpp"
+
+#include "tests/unit/core/io/MemoryReaderWriter.h"
+
+#include "core/utils/Random.h"
+
+#include <array>
+#include <chrono>
+#include <functional>
+
+#include <cstdint>
+#include <cstdio>
+
+// Serialization micro-benchmark.
+// Compares the std::function based reader/writer callbacks with streaming directly from/to a memory source/sink
+// and reading note steps one by one with reading them in bulk.
+
+// sequences are not routed in this benchmark
+bool Routing::isRouted(Target target, int trackIndex) {
+    return false;
+}
+
+static constexpr int SequenceCount = 8 * (CONFIG_PATTERN_COUNT + CONFIG_SNAPSHOT_COUNT);
+static constexpr int Iterations = 20;
+
+static std::array<NoteSequence, SequenceCount> sequences;
+static std::array<NoteSequence, SequenceCount> readSequences;
+static uint8_t buffer[SequenceCount * sizeof(NoteSequence) + 1024];
+static uint8_t referenceBuffer[sizeof(buffer)];
+
+static double measure(std::function<void()> func) {
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < Iterations; ++i) {
+        func();
+    }
+    return std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start).count() * 1e6 / Iterations;
+}
+
+static void compare(const char *name, std::function<void()> referenceFunc, std::function<void()> streamingFunc) {
+    double referenceUs = measure(referenceFunc);
+    double streamingUs = measure(streamingFunc);
+    std::printf("%-24s %10.1f %10.1f %8.2fx\n", name, referenceUs, streamingUs, referenceUs / streamingUs);
+}
+
+static void writeCallback(uint8_t *buf) {
+    MemoryWriter memoryWriter(buf, sizeof(buffer));
+    VersionedSerializedWriter writer([&memoryWriter] (const void *data, size_t len) { memoryWriter.write(data, len); }, ProjectVersion::Latest);
+    for (const auto &sequence : sequences) {
+        sequence.write(writer);
+    }
+    writer.writeHash();
+}
+
+static size_t writeStreaming(uint8_t *buf) {
+    MemoryWriter memoryWriter(buf, sizeof(buffer));
+    VersionedSerializedWriter writer(memoryWriter, ProjectVersion::Latest);
+    for (const auto &sequence : sequences) {
+        sequence.write(writer);
+    }
+    writer.writeHash();
+    return memoryWriter.bytesWritten();
+}
+
+static bool readCallback(const uint8_t *buf) {
+    MemoryReader memoryReader(buf, sizeof(buffer));
+    VersionedSerializedReader reader([&memoryReader] (void *data, size_t len) { memoryReader.read(data, len); }, ProjectVersion::Latest);
+    for (auto &sequence : readSequences) {
+        sequence.read(reader);
+    }
+    return reader.checkHash();
+}
+
+static bool readStreaming(const uint8_t *buf) {
+    MemoryReader memoryReader(buf, sizeof(buffer));
+    VersionedSerializedReader reader(memoryReader, ProjectVersion::Latest);
+    for (auto &sequence : readSequences) {
+        sequence.read(reader);
+    }
+    return reader.checkHash();
+}
+
+static void writeSteps(uint8_t *buf) {
+    MemoryWriter memoryWriter(buf, sizeof(buffer));
+    VersionedSerializedWriter writer(memoryWriter, ProjectVersion::Latest);
+    for (const auto &sequence : sequences) {
+        for (const auto &step : sequence.steps()) {
+            step.write(writer);
+        }
+    }
+}
+
+static void readStepsSingle(const uint8_t *buf) {
+    MemoryReader memoryReader(buf, sizeof(buffer));
+    VersionedSerializedReader reader(memoryReader, ProjectVersion::Latest);
+    for (auto &sequence : readSequences) {
+        for (auto &step : sequence.steps()) {
+            step.read(reader);
+        }
+    }
+}
+
+static void readStepsBulk(const uint8_t *buf) {
+    MemoryReader memoryReader(buf, sizeof(buffer));
+    VersionedSerializedReader reader(memoryReader, ProjectVersion::Latest);
+    for (auto &sequence : readSequences) {
+        reader.read(sequence.steps().data(), sizeof(NoteSequence::StepArray), 0);
+    }
+}
+
+static bool sequencesEqual() {
+    for (int i = 0; i < SequenceCount; ++i) {
+        if (sequences[i].steps() != readSequences[i].steps() || sequences[i].seed() != readSequences[i].seed()) {
+            return false;
+        }
+    }
+    return true;
+}
+
+int main() {
+    Random rng;
+    for (auto &sequence : sequences) {
+        sequence.setSeed(rng.next());
+        for (auto &step : sequence.steps()) {
+            step.setGate(rng.next() & 1);
+            step.setNote(int(rng.next() % 64) - 32);
+            step.setLength(rng.next() % NoteSequence::Length::Range);
+            step.setGateProbability(rng.next() % NoteSequence::GateProbability::Range);
+        }
+    }
+
+    // both writers need to produce the same data
+    writeCallback(referenceBuffer);
+    size_t size = writeStreaming(buffer);
+    if (std::memcmp(buffer, referenceBuffer, sizeof(buffer)) != 0) {
+        std::printf("streaming writer output differs\n");
+        return 1;
+    }
+    if (!readStreaming(buffer) || !sequencesEqual()) {
+        std::printf("streaming reader failed\n");
+        return 1;
+    }
+
+    std::printf("%d sequences, %d bytes\n", SequenceCount, int(size));
+    std::printf("%-24s %10s %10s %9s\n", "operation (us)", "callback", "streaming", "speedup");
+
+    compare("write sequences", [] () { writeCallback(buffer); }, [] () { writeStreaming(buffer); });
+    compare("read sequences", [] () { readCallback(buffer); }, [] () { readStreaming(buffer); });
+
+    // step data only
+    writeSteps(buffer);
+    std::printf("%-24s %10s %10s %9s\n", "", "single", "bulk", "");
+    compare("read steps", [] () { readStepsSingle(buffer); }, [] () { readStepsBulk(buffer); });
+
+    return 0;
+}
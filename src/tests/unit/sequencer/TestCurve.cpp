@@ -18,6 +18,19 @@ float brightness = 1.0;
 
 UNIT_TEST("Curve") {
 
+    CASE("fixed point evaluation") {
+        // step lengths in ticks
+        for (uint32_t length : { 12, 48, 192, 768, 3072 }) {
+            for (int type = 0; type < Curve::Last; ++type) {
+                for (uint32_t position = 0; position < length; ++position) {
+                    float value = float(Curve::evalFixed(Curve::Type(type), position, length)) / Curve::FixedOne;
+                    float expected = Curve::eval(Curve::Type(type), float(position) / length);
+                    expectTrue(std::abs(value - expected) < 0.001f);
+                }
+            }
+        }
+    }
+
 #ifdef PLATFORM_SIM
 
     CASE("markdown") {
@@ -0,0 +1,70 @@
+// model sources first, they use a local CASE macro
+#include "apps/sequencer/model/Calibration.cpp"
+
+#include "apps/sequencer/engine/CvOutput.cpp"
+
+#include "UnitTest.h"
+
+#include <cstdlib>
+
+static bool closeTo(int a, int b) {
+    return std::abs(a - b) <= 1;
+}
+
+UNIT_TEST("CvOutput") {
+
+    CASE("matches calibration") {
+        Calibration calibration;
+        calibration.clear();
+        calibration.cvOutput(1).setItem(3, 20000);
+        calibration.cvOutput(1).setUserDefined(3, true);
+
+        CvOutput cvOutput(calibration);
+        cvOutput.init();
+
+        for (int i = 0; i <= 240; ++i) {
+            float volts = -6.f + i * 0.05f;
+            for (int channel = 0; channel < CvOutput::Channels; ++channel) {
+                cvOutput.setChannel(channel, volts);
+            }
+            cvOutput.update();
+            for (int channel = 0; channel < CvOutput::Channels; ++channel) {
+                expectTrue(closeTo(cvOutput.value(channel), calibration.cvOutput(channel).voltsToValue(volts)));
+                expectEqual(int(cvOutput.nextValue(channel)), int(cvOutput.value(channel)));
+            }
+        }
+    }
+
+    CASE("converts next values") {
+        Calibration calibration;
+        calibration.clear();
+
+        CvOutput cvOutput(calibration);
+        cvOutput.init();
+
+        cvOutput.setChannel(0, 1.f);
+        cvOutput.setNextChannel(0, 2.f);
+        cvOutput.update();
+        expectTrue(closeTo(cvOutput.value(0), calibration.cvOutput(0).voltsToValue(1.f)));
+        expectTrue(closeTo(cvOutput.nextValue(0), calibration.cvOutput(0).voltsToValue(2.f)));
+    }
+
+    CASE("follows calibration changes") {
+        Calibration calibration;
+        calibration.clear();
+
+        CvOutput cvOutput(calibration);
+        cvOutput.init();
+
+        cvOutput.setChannel(2, 0.5f);
+        cvOutput.update();
+        expectTrue(closeTo(cvOutput.value(2), calibration.cvOutput(2).voltsToValue(0.5f)));
+
+        // same voltage, changed calibration
+        calibration.cvOutput(2).setItem(5, 10000);
+        calibration.cvOutput(2).setUserDefined(5, true);
+        cvOutput.update();
+        expectTrue(closeTo(cvOutput.value(2), calibration.cvOutput(2).voltsToValue(0.5f)));
+    }
+
+}
@@ -0,0 +1,166 @@
+#include "apps/sequencer/ui/controllers/launchpad/LaunchpadDevice.cpp"
+#include "apps/sequencer/ui/controllers/launchpad/LaunchpadMk2Device.cpp"
+#include "apps/sequencer/ui/controllers/launchpad/LaunchpadProDevice.cpp"
+
+#include "UnitTest.h"
+
+#include <vector>
+
+// records messages sent by a device and counts the bytes sent over usb
+struct UsbMidiRecorder {
+    std::vector<MidiMessage> queue;
+    int messages = 0;
+    int bytes = 0;
+
+    void attach(LaunchpadDevice &device) {
+        device.setSendMidiHandler([this] (uint8_t cable, const MidiMessage &message) {
+            queue.emplace_back(message);
+            ++messages;
+            // usb midi event packets carry 3 bytes of a system exclusive message, other messages take a packet each
+            bytes += message.isSystemExclusive() ? ((message.payloadLength() + 2 + 2) / 3) * 4 : 4;
+            return true;
+        });
+    }
+
+    // releases queued messages and their payloads
+    void transmit() {
+        queue.clear();
+    }
+
+    void reset() {
+        transmit();
+        messages = 0;
+        bytes = 0;
+    }
+};
+
+static void setAllLeds(LaunchpadDevice &device, int red, int green) {
+    for (int row = 0; row < LaunchpadDevice::Rows + LaunchpadDevice::ExtraRows; ++row) {
+        for (int col = 0; col < LaunchpadDevice::Cols; ++col) {
+            device.setLed(row, col, red, green, 0);
+        }
+    }
+}
+
+static uint8_t payloadPool[4 * 48];
+
+UNIT_TEST("LaunchpadDevice") {
+
+    MidiMessage::setPayloadPool(payloadPool, sizeof(payloadPool));
+
+    CASE("sends changed leds only") {
+        LaunchpadDevice device;
+        UsbMidiRecorder recorder;
+        recorder.attach(device);
+
+        setAllLeds(device, 1, 0);
+        device.syncLeds();
+        expectEqual(recorder.messages, LaunchpadDevice::ButtonCount);
+        expectEqual(recorder.bytes, LaunchpadDevice::ButtonCount * 4);
+
+        recorder.reset();
+        device.syncLeds();
+        expectEqual(recorder.messages, 0);
+
+        device.setLed(3, 4, 2, 2, 0);
+        device.syncLeds();
+        expectEqual(recorder.messages, 1);
+        expectEqual(recorder.bytes, 4);
+    }
+
+    CASE("limits messages and sends from the given column") {
+        LaunchpadDevice device;
+        UsbMidiRecorder recorder;
+        recorder.attach(device);
+
+        device.syncLeds();
+        recorder.reset();
+
+        for (int row = 0; row < LaunchpadDevice::Rows; ++row) {
+            device.setLed(row, 2, 3, 0, 0);
+            device.setLed(row, 5, 3, 0, 0);
+        }
+
+        expectEqual(device.syncLeds(LaunchpadDevice::Rows, 5), LaunchpadDevice::Rows);
+        expectFalse(device.ledsSynced());
+        for (int row = 0; row < LaunchpadDevice::Rows; ++row) {
+            expectEqual(int(recorder.queue[row].note()), row * 16 + 5);
+        }
+
+        recorder.reset();
+        expectEqual(device.syncLeds(), LaunchpadDevice::Rows);
+        expectTrue(device.ledsSynced());
+        expectEqual(int(recorder.queue[0].note()), 2);
+    }
+
+    CASE("batches leds into system exclusive messages") {
+        LaunchpadMk2Device device;
+        UsbMidiRecorder recorder;
+        recorder.attach(device);
+
+        // full frame, the payload pool holds 4 messages until they are transmitted
+        setAllLeds(device, 1, 0);
+        int frameBytes = 0;
+        for (int i = 0; i < 2; ++i) {
+            device.syncLeds();
+            frameBytes += recorder.bytes;
+            recorder.reset();
+        }
+        expectTrue(frameBytes < LaunchpadDevice::ButtonCount * 4);
+
+        device.syncLeds();
+        expectEqual(recorder.messages, 0);
+
+        // single led
+        device.setLed(3, 4, 2, 2, 0);
+        device.syncLeds();
+        expectEqual(recorder.messages, 1);
+        expectEqual(recorder.bytes, 16);
+        const auto &message = recorder.queue.front();
+        expectEqual(int(message.payloadLength()), 8);
+        expectEqual(int(message.payloadData()[6]), 11 + 10 * (7 - 3) + 4);
+    }
+
+    CASE("uses device led numbers") {
+        LaunchpadProDevice device;
+        UsbMidiRecorder recorder;
+        recorder.attach(device);
+
+        for (int i = 0; i < 2; ++i) {
+            device.syncLeds();
+            recorder.reset();
+        }
+
+        device.setLed(LaunchpadDevice::SceneRow, 0, 3, 0, 0);
+        device.setLed(LaunchpadDevice::FunctionRow, 7, 3, 0, 0);
+        device.syncLeds();
+        expectEqual(recorder.messages, 1);
+        const auto &message = recorder.queue.front();
+        expectEqual(int(message.payloadLength()), 10);
+        expectEqual(int(message.payloadData()[6]), 89);
+        expectEqual(int(message.payloadData()[8]), 98);
+    }
+
+    CASE("resumes when payloads are released") {
+        LaunchpadMk2Device device;
+        UsbMidiRecorder recorder;
+        recorder.attach(device);
+
+        setAllLeds(device, 2, 1);
+        device.syncLeds();
+        expectEqual(recorder.messages, 4);
+
+        // pool is used up by queued messages
+        device.syncLeds();
+        expectEqual(recorder.messages, 4);
+
+        recorder.transmit();
+        device.syncLeds();
+        expectEqual(recorder.messages, 5);
+
+        recorder.reset();
+        device.syncLeds();
+        expectEqual(recorder.messages, 0);
+    }
+
+}
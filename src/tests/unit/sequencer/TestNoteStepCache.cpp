@@ -0,0 +1,108 @@
+// model sources first, they use a local CASE macro
+#include "apps/sequencer/model/NoteSequence.cpp"
+#include "apps/sequencer/model/Scale.cpp"
+#include "apps/sequencer/model/UserScale.cpp"
+
+#include "apps/sequencer/engine/NoteStepCache.h"
+
+#include "UnitTest.h"
+
+// sequences are not routed in this test
+bool Routing::isRouted(Target target, int trackIndex) {
+    return false;
+}
+
+static float expectedVolts(const Scale &scale, int note, int rootNote) {
+    return scale.noteToVolts(note) + (scale.isChromatic() ? rootNote : 0) * (1.f / 12.f);
+}
+
+UNIT_TEST("NoteStepCache") {
+
+    CASE("resolves step voltages") {
+        NoteSequence sequence;
+        for (int i = 0; i < CONFIG_STEP_COUNT; ++i) {
+            sequence.step(i).setNote(i - 32);
+        }
+
+        NoteStepCache cache;
+        for (int scaleIndex = 0; scaleIndex < Scale::Count; ++scaleIndex) {
+            const auto &scale = Scale::get(scaleIndex);
+            for (int octave = -1; octave <= 1; ++octave) {
+                cache.setup(sequence, scale, 3, octave, 2);
+                int transposition = octave * scale.notesPerOctave() + 2;
+                expectEqual(cache.transposition(), transposition);
+                for (int i = 0; i < CONFIG_STEP_COUNT; ++i) {
+                    cache.resolve(i);
+                    expectEqual(cache.stepVolts(i), expectedVolts(scale, i - 32 + transposition, 3));
+                }
+            }
+        }
+    }
+
+    CASE("rebuilds edited steps") {
+        NoteSequence sequence;
+        const auto &scale = Scale::get(0);
+
+        NoteStepCache cache;
+        cache.setup(sequence, scale, 0, 0, 0);
+        cache.resolve(5);
+        expectEqual(cache.stepVolts(5), expectedVolts(scale, 0, 0));
+
+        sequence.step(5).setNote(7);
+        cache.setup(sequence, scale, 0, 0, 0);
+        cache.resolve(5);
+        expectEqual(cache.stepVolts(5), expectedVolts(scale, 7, 0));
+
+        sequence.step(5).setCondition(Types::Condition(int(Types::Condition::Loop) + 3));
+        cache.resolve(5);
+        auto loop = Types::conditionLoop(sequence.step(5).condition());
+        expectEqual(int(cache.stepConditionLoop(5).base), int(loop.base));
+        expectEqual(int(cache.stepConditionLoop(5).offset), int(loop.offset));
+    }
+
+    CASE("rebuilds on setting changes") {
+        NoteSequence sequence;
+        sequence.step(0).setNote(4);
+        const auto &scale = Scale::get(0);
+
+        NoteStepCache cache;
+        cache.setup(sequence, scale, 0, 0, 0);
+        cache.resolve(0);
+        expectEqual(cache.stepVolts(0), expectedVolts(scale, 4, 0));
+
+        cache.setup(sequence, scale, 5, 0, 0);
+        cache.resolve(0);
+        expectEqual(cache.stepVolts(0), expectedVolts(scale, 4, 5));
+
+        cache.setup(sequence, scale, 5, 0, -3);
+        cache.resolve(0);
+        expectEqual(cache.stepVolts(0), expectedVolts(scale, 1, 5));
+    }
+
+    CASE("follows user scale edits") {
+        NoteSequence sequence;
+        sequence.step(0).setNote(1);
+        auto &userScale = UserScale::userScales[0];
+        userScale.clear();
+        userScale.setSize(2);
+        userScale.setItem(1, 4);
+
+        NoteStepCache cache;
+        cache.setup(sequence, userScale, 0, 0, 0);
+        cache.resolve(0);
+        expectEqual(cache.stepVolts(0), 4 * (1.f / 12.f));
+
+        userScale.setItem(1, 7);
+        cache.setup(sequence, userScale, 0, 0, 0);
+        cache.resolve(0);
+        expectEqual(cache.stepVolts(0), 7 * (1.f / 12.f));
+
+        UserScale copy = userScale;
+        userScale.setItem(1, 2);
+        userScale = copy;
+        cache.setup(sequence, userScale, 0, 0, 0);
+        cache.resolve(0);
+        expectEqual(cache.stepVolts(0), 7 * (1.f / 12.f));
+    }
+
+}